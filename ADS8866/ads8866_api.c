@@ -19,6 +19,11 @@
  */
 static float ads8866_vref = 3.3f;
 
+/**
+ * @brief Health counters of the ADC
+ */
+static driver_health_t ads8866_health;
+
 /**
  * @brief Read a conversion from the ADS8866 ADC
  * 
@@ -35,6 +40,7 @@ ads8866_data_t ads8866_read(void){
 
     // Perform SPI read
     result = ads8866_platform_spi_read();
+    ads8866_health.transfers++;
 
     data.digital_value = result;
     data.voltage = (result * ads8866_vref) / 65536.0f; 
@@ -42,6 +48,20 @@ ads8866_data_t ads8866_read(void){
     return data;
 }
 
+/**
+ * @brief Read a raw conversion from the ADS8866 ADC
+ * 
+ * No floating point math is done, so this function is safe to call
+ * from timer interrupts at the full conversion rate.
+ * 
+ * @return uint16_t Raw 16-bit conversion result
+ */
+uint16_t ads8866_read_raw(void){
+    uint16_t result = ads8866_platform_spi_read();
+    ads8866_health.transfers++;
+    return result;
+}
+
 /**
  * @brief Set the ADC reference voltage for voltage calculations
  * 
@@ -56,6 +76,7 @@ bool ads8866_set_vref(float vref){
         ads8866_vref = vref;
         return true;
     }
+    driver_health_error(&ads8866_health, DRIVER_STATUS_INVALID_ARG);
     return false;
 }
 
@@ -66,4 +87,20 @@ bool ads8866_set_vref(float vref){
  */
 float ads8866_get_vref(void){
     return ads8866_vref;
+}
+
+/**
+ * @brief Get the health counters of the ADC
+ * 
+ * @return const driver_health_t* Pointer to the live counters
+ */
+const driver_health_t* ads8866_get_health(void){
+    return &ads8866_health;
+}
+
+/**
+ * @brief Clear the health counters of the ADC
+ */
+void ads8866_reset_health(void){
+    driver_health_reset(&ads8866_health);
 }
\ No newline at end of file
@@ -22,6 +22,7 @@
 
 #include <stdint.h>
 #include "ads8866_platform.h"
+#include "driver_status.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -48,6 +49,16 @@ typedef struct {
  */
 ads8866_data_t ads8866_read(void);
 
+/**
+ * @brief Read a raw conversion result from the ADS8866 ADC
+ * 
+ * Same as ads8866_read() without the voltage calculation. Intended for
+ * control loops and capture paths that work directly with ADC codes.
+ *
+ * @return uint16_t Raw 16-bit conversion result (0-65535)
+ */
+uint16_t ads8866_read_raw(void);
+
 /**
  * @brief Set the reference voltage for ADC calculations
  * 
@@ -66,6 +77,21 @@ bool ads8866_set_vref(float vref);
  */
 float ads8866_get_vref(void);
 
+/**
+ * @brief Get the health counters of the ADC
+ * 
+ * The ADS8866 has no command interface, so only transfers and rejected
+ * calls are counted.
+ * 
+ * @return const driver_health_t* Pointer to the live counters
+ */
+const driver_health_t* ads8866_get_health(void);
+
+/**
+ * @brief Clear the health counters of the ADC
+ */
+void ads8866_reset_health(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,195 @@
+/**
+ * @file auto_range_api.c
+ * @brief Implementation of the auto-ranging gain engine
+ *
+ * @author Alejandro Beltran
+ * @date October 2026
+ */
+
+#include "auto_range_api.h"
+#include "auto_range_platform.h"
+
+#include "adc124s021_api.h"
+
+/**
+ * @brief Engine state
+ *
+ * The search works on a gain index from 0 (lowest gain) to `span` (highest
+ * gain), mapped to the wiper range according to `gain_decreasing`. The
+ * configuration is only replaced once its initial wiper code has been
+ * written, so `configured` always describes the wiper on the device.
+ */
+static struct {
+    bool configured;
+    auto_range_config_t config;
+    auto_range_report_t report;
+    auto_range_stats_t stats;
+    int32_t span;
+    int32_t gain;
+} range;
+
+static uint16_t auto_range_wiper_of(int32_t gain)
+{
+    if (range.config.gain_decreasing)
+    {
+        return (uint16_t)(range.config.wiper_max - gain);
+    }
+    return (uint16_t)(range.config.wiper_min + gain);
+}
+
+static driver_status_t auto_range_apply(int32_t gain)
+{
+    if (!mcp4xxx_set_wiper(range.config.pot_address, range.config.wiper, auto_range_wiper_of(gain)))
+    {
+        return mcp4xxx_get_health(range.config.pot_address)->last_error;
+    }
+    range.gain = gain;
+    range.stats.wiper_writes++;
+    auto_range_platform_delay_us(range.config.settle_us);
+    return DRIVER_STATUS_OK;
+}
+
+static driver_status_t auto_range_measure(auto_range_reading_t *reading, bool ranged)
+{
+    driver_status_t status = adc124s021_read_channel(range.config.adc_channel, &reading->value);
+    if (status != DRIVER_STATUS_OK)
+    {
+        return status;
+    }
+    reading->wiper = auto_range_wiper_of(range.gain);
+    reading->in_window = reading->value >= range.config.window_low && reading->value <= range.config.window_high;
+    reading->ranged = ranged;
+    range.stats.readings++;
+    if (range.report != NULL)
+    {
+        range.report(reading);
+    }
+    return DRIVER_STATUS_OK;
+}
+
+driver_status_t auto_range_configure(const auto_range_config_t *config, auto_range_report_t report)
+{
+    if (config == NULL || config->adc_channel > 3 || config->wiper_min > config->wiper_max ||
+        !mcp4xxx_has_wiper(config->pot_address, config->wiper) ||
+        config->wiper_max > mcp4xxx_max_wiper(config->pot_address) ||
+        config->wiper_initial < config->wiper_min || config->wiper_initial > config->wiper_max ||
+        config->window_low > config->window_high || config->window_high > 4095)
+    {
+        return DRIVER_STATUS_INVALID_ARG;
+    }
+
+    // A failed write keeps the previous configuration
+    if (!mcp4xxx_set_wiper(config->pot_address, config->wiper, config->wiper_initial))
+    {
+        return mcp4xxx_get_health(config->pot_address)->last_error;
+    }
+    range.config = *config;
+    range.report = report;
+    range.span = config->wiper_max - config->wiper_min;
+    int32_t offset = config->wiper_initial - config->wiper_min;
+    range.gain = config->gain_decreasing ? range.span - offset : offset;
+    range.configured = true;
+    range.stats.wiper_writes++;
+    auto_range_platform_delay_us(config->settle_us);
+    return DRIVER_STATUS_OK;
+}
+
+driver_status_t auto_range_read(auto_range_reading_t *reading)
+{
+    if (!range.configured || reading == NULL)
+    {
+        return DRIVER_STATUS_INVALID_ARG;
+    }
+
+    driver_status_t status = auto_range_measure(reading, false);
+    if (status != DRIVER_STATUS_OK)
+    {
+        return status;
+    }
+
+    // Hysteresis: keep the gain while the signal stays inside the widened window
+    int32_t value = reading->value;
+    if (value >= (int32_t)range.config.window_low - range.config.hysteresis &&
+        value <= (int32_t)range.config.window_high + range.config.hysteresis)
+    {
+        return DRIVER_STATUS_OK;
+    }
+    range.stats.searches++;
+
+    // Binary search on the gain index; `best` is the highest gain seen that
+    // does not exceed the window
+    int32_t low = 0;
+    int32_t high = range.span;
+    int32_t best = -1;
+    if (reading->value > range.config.window_high)
+    {
+        high = range.gain - 1;
+    }
+    else
+    {
+        low = range.gain + 1;
+        best = range.gain;
+    }
+
+    while (low <= high)
+    {
+        int32_t mid = (low + high) / 2;
+        status = auto_range_apply(mid);
+        if (status == DRIVER_STATUS_OK)
+        {
+            status = auto_range_measure(reading, true);
+        }
+        if (status != DRIVER_STATUS_OK)
+        {
+            return status;
+        }
+        if (reading->in_window)
+        {
+            return DRIVER_STATUS_OK;
+        }
+        if (reading->value > range.config.window_high)
+        {
+            high = mid - 1;
+        }
+        else
+        {
+            low = mid + 1;
+            best = mid;
+        }
+    }
+
+    // The window is unreachable: settle on the highest gain that does not clip
+    range.stats.unreachable++;
+    if (best < 0)
+    {
+        best = 0;
+    }
+    if (best != range.gain)
+    {
+        status = auto_range_apply(best);
+        if (status == DRIVER_STATUS_OK)
+        {
+            status = auto_range_measure(reading, true);
+        }
+    }
+    return status;
+}
+
+uint16_t auto_range_get_wiper(void)
+{
+    if (!range.configured)
+    {
+        return 0;
+    }
+    return auto_range_wiper_of(range.gain);
+}
+
+const auto_range_stats_t* auto_range_get_stats(void)
+{
+    return &range.stats;
+}
+
+void auto_range_reset_stats(void)
+{
+    range.stats = (auto_range_stats_t){ 0 };
+}
@@ -0,0 +1,127 @@
+/**
+ * @file auto_range_api.h
+ * @brief Automatic gain ranging with an MCP4XXX gain element and ADC124S021 feedback
+ *
+ * An MCP4XXX wiper sets the gain of the stage ahead of one ADC124S021
+ * channel. Each reading is compared with a target window; when it falls
+ * outside the window widened by a hysteresis band, the wiper is re-ranged by
+ * binary search over the allowed codes, which settles in about log2(steps)
+ * wiper writes and ADC reads. Every reading is returned together with the
+ * wiper code that was active when it was taken.
+ *
+ * The gain is assumed to be monotonic in the wiper code.
+ *
+ * @author Alejandro Beltran
+ * @date October 2026
+ */
+
+#ifndef AUTO_RANGE_API_H
+#define AUTO_RANGE_API_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "driver_status.h"
+#include "mcp4xxx_api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Engine configuration
+ *
+ * The window is in raw 12-bit ADC codes. Re-ranging starts when a reading is
+ * below `window_low - hysteresis` or above `window_high + hysteresis`, and a
+ * search stops at the first reading inside `window_low` to `window_high`.
+ */
+typedef struct {
+    uint8_t pot_address;        /**< I2C address of the MCP4XXX */
+    mcp4xxx_wiper_t wiper;      /**< Wiper used as gain element */
+    uint16_t wiper_min;         /**< Lowest allowed wiper code */
+    uint16_t wiper_max;         /**< Highest allowed wiper code */
+    uint16_t wiper_initial;     /**< Wiper code written by auto_range_configure() */
+    bool gain_decreasing;       /**< true if a higher wiper code gives a lower gain */
+    uint8_t adc_channel;        /**< ADC124S021 channel (0-3) */
+    uint16_t window_low;        /**< Lower bound of the target window */
+    uint16_t window_high;       /**< Upper bound of the target window */
+    uint16_t hysteresis;        /**< Extra margin before re-ranging */
+    uint32_t settle_us;         /**< Wait after each wiper change before reading */
+} auto_range_config_t;
+
+/**
+ * @brief One ADC reading and the gain it was taken with
+ */
+typedef struct {
+    uint16_t value;             /**< Raw 12-bit ADC code */
+    uint16_t wiper;             /**< Wiper code active during the conversion */
+    bool in_window;             /**< The value is inside the target window */
+    bool ranged;                /**< The gain was changed to obtain this reading */
+} auto_range_reading_t;
+
+/**
+ * @brief Optional callback receiving every ADC reading, including search steps
+ */
+typedef void (*auto_range_report_t)(const auto_range_reading_t *reading);
+
+/**
+ * @brief Engine statistics
+ */
+typedef struct {
+    uint32_t readings;          /**< ADC readings taken, including search steps */
+    uint32_t searches;          /**< Re-ranging searches started */
+    uint32_t wiper_writes;      /**< Wiper changes */
+    uint32_t unreachable;       /**< Searches that ended without a reading in the window */
+} auto_range_stats_t;
+
+/**
+ * @brief Configure the engine and write the initial wiper code
+ *
+ * The configuration takes effect only once the initial wiper code has been
+ * written; on any error the previous configuration, if any, stays active.
+ *
+ * @param config Engine configuration; `wiper` must exist on the device (see mcp4xxx_has_wiper())
+ * @param report Callback for every reading, may be NULL
+ * @return driver_status_t DRIVER_STATUS_OK on success, DRIVER_STATUS_INVALID_ARG or the pot error otherwise
+ */
+driver_status_t auto_range_configure(const auto_range_config_t *config, auto_range_report_t report);
+
+/**
+ * @brief Take a reading, re-ranging the gain if needed
+ *
+ * If the first reading is outside the hysteresis band the gain is searched
+ * and `reading` holds the final reading of the search. When no wiper code
+ * brings the signal into the window, the highest gain that does not exceed
+ * the window is kept and `in_window` is false.
+ *
+ * @param reading Pointer to store the reading
+ * @return driver_status_t DRIVER_STATUS_OK on success, DRIVER_STATUS_INVALID_ARG
+ *         if the engine has not been configured or `reading` is NULL, the
+ *         device error otherwise
+ */
+driver_status_t auto_range_read(auto_range_reading_t *reading);
+
+/**
+ * @brief Get the wiper code currently applied
+ *
+ * @return uint16_t Wiper code, 0 before the first successful auto_range_configure()
+ */
+uint16_t auto_range_get_wiper(void);
+
+/**
+ * @brief Get the engine statistics
+ *
+ * @return const auto_range_stats_t* Pointer to the live statistics
+ */
+const auto_range_stats_t* auto_range_get_stats(void);
+
+/**
+ * @brief Clear the engine statistics
+ */
+void auto_range_reset_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AUTO_RANGE_API_H */
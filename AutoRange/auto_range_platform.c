@@ -0,0 +1,17 @@
+/**
+ * @file auto_range_platform.c
+ * @brief Implementation of platform-specific functions for the auto-ranging gain engine
+ *
+ * These functions should be implemented according to the specific platform
+ * being used.
+ *
+ * @author Alejandro Beltran
+ * @date October 2026
+ */
+
+#include "auto_range_platform.h"
+
+void auto_range_platform_delay_us(uint32_t delay_us)
+{
+    // TODO - Implement a microsecond busy-wait for the target platform
+}
@@ -0,0 +1,34 @@
+/**
+ * @file auto_range_platform.h
+ * @brief Platform-specific interface for the auto-ranging gain engine
+ *
+ * This file declares the hardware abstraction layer functions needed by
+ * the gain engine.
+ *
+ * @author Alejandro Beltran
+ * @date October 2026
+ */
+
+#ifndef AUTO_RANGE_PLATFORM_H
+#define AUTO_RANGE_PLATFORM_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Busy-wait for the given number of microseconds
+ *
+ * Used to let the gain stage settle after each wiper change.
+ *
+ * @param delay_us Delay in microseconds
+ */
+void auto_range_platform_delay_us(uint32_t delay_us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AUTO_RANGE_PLATFORM_H */
@@ -0,0 +1,400 @@
+/**
+ * @file cdc_command.c
+ * @brief Implementation of the table-driven command dispatcher
+ *
+ * The index is an open addressing table of pointers to the registered
+ * entries, indexed by the top CDC_COMMAND_INDEX_BITS bits of the name hash
+ * with linear probing. It is kept at most half full in normal use, so a
+ * lookup usually touches one or two slots.
+ *
+ * Machine mode responses are assembled in a static buffer and sent with a
+ * single write once every command of the line has run.
+ *
+ * @author Alejandro Beltran
+ * @date October 2026
+ */
+
+#include "cdc_command.h"
+#include "cdc_usb_platform.h"
+
+#include <string.h>
+
+#define CDC_COMMAND_INDEX_SIZE (1U << CDC_COMMAND_INDEX_BITS)
+// Every command of a line takes at least two characters ("x;") and its
+// result two (";0"), so the results of a whole line always fit next to the
+// handler data
+#define CDC_COMMAND_RESPONSE_SIZE (APP_READ_BUFFER_SIZE + 16 + CDC_COMMAND_RESPONSE_DATA_MAX)
+
+static const cdc_command_t *command_index_table[CDC_COMMAND_INDEX_SIZE];
+static uint16_t command_count;
+
+static cdc_command_mode_t command_mode = CDC_COMMAND_MODE_INTERACTIVE;
+static cdc_command_mode_t line_mode = CDC_COMMAND_MODE_INTERACTIVE;
+static uint16_t sequence_base;        // Number of the first machine mode line
+static char command_response[CDC_COMMAND_RESPONSE_SIZE];
+static uint16_t response_length;
+static uint16_t response_data;
+
+/**
+ * @brief Runtime counterpart of CDC_COMMAND_HASH()
+ */
+static uint32_t cdc_command_hash(const char *name, size_t length){
+    uint32_t hash = (uint32_t)length * 0x85EBCA6Bu;
+    for(size_t i = 0; i < length; i++){
+        hash += (uint32_t)(uint8_t)name[i] * CDC_COMMAND_WEIGHT(i);
+    }
+    return hash;
+}
+
+static uint16_t cdc_command_slot(uint32_t hash){
+    return (uint16_t)(hash >> (32 - CDC_COMMAND_INDEX_BITS));
+}
+
+static const cdc_command_t* cdc_command_lookup(const char *name, size_t length){
+    if(length == 0 || length > CDC_COMMAND_NAME_MAX){
+        return NULL;
+    }
+    uint32_t hash = cdc_command_hash(name, length);
+    uint16_t slot = cdc_command_slot(hash);
+    while(command_index_table[slot] != NULL){
+        const cdc_command_t *command = command_index_table[slot];
+        if(command->hash == hash && strcmp(command->name, name) == 0){
+            return command;
+        }
+        slot = (slot + 1) & (CDC_COMMAND_INDEX_SIZE - 1);
+    }
+    return NULL;
+}
+
+bool cdc_command_register(const cdc_command_t *commands, uint16_t count){
+    if(commands == NULL){
+        return false;
+    }
+    for(uint16_t i = 0; i < count; i++){
+        const cdc_command_t *command = &commands[i];
+        if(command->name == NULL || command->handler == NULL){
+            return false;
+        }
+        size_t length = strlen(command->name);
+        // A hash mismatch means the entry was not declared with CDC_COMMAND()
+        if(length == 0 || length > CDC_COMMAND_NAME_MAX ||
+           command->hash != cdc_command_hash(command->name, length)){
+            return false;
+        }
+        // One slot always stays empty so that lookups terminate
+        if(command_count >= CDC_COMMAND_INDEX_SIZE - 1 ||
+           cdc_command_lookup(command->name, length) != NULL){
+            return false;
+        }
+        uint16_t slot = cdc_command_slot(command->hash);
+        while(command_index_table[slot] != NULL){
+            slot = (slot + 1) & (CDC_COMMAND_INDEX_SIZE - 1);
+        }
+        command_index_table[slot] = command;
+        command_count++;
+    }
+    return true;
+}
+
+const cdc_command_t* cdc_command_find(const char *name){
+    if(name == NULL){
+        return NULL;
+    }
+    return cdc_command_lookup(name, strlen(name));
+}
+
+/**
+ * @brief Split a line in place into tokens
+ *
+ * @return Number of tokens, CDC_COMMAND_MAX_ARGS + 1 if there are more
+ */
+static uint8_t cdc_command_tokenize(char *line, char **argv){
+    uint8_t argc = 0;
+    char *p = line;
+    for(;;){
+        while(*p == ' ' || *p == '\t'){
+            p++;
+        }
+        if(*p == '\0'){
+            return argc;
+        }
+        if(argc == CDC_COMMAND_MAX_ARGS){
+            return CDC_COMMAND_MAX_ARGS + 1;
+        }
+        argv[argc++] = p;
+        while(*p != '\0' && *p != ' ' && *p != '\t'){
+            p++;
+        }
+        if(*p != '\0'){
+            *p++ = '\0';
+        }
+    }
+}
+
+/**
+ * @brief Append text to the machine mode response
+ */
+static bool cdc_command_append(const char *text, size_t length){
+    if(length > CDC_COMMAND_RESPONSE_SIZE - response_length){
+        return false;
+    }
+    memcpy(&command_response[response_length], text, length);
+    response_length += length;
+    return true;
+}
+
+static void cdc_command_append_number(uint32_t value){
+    char digits[10];
+    uint8_t count = 0;
+    do {
+        digits[count++] = '0' + (value % 10);
+        value /= 10;
+    } while(value != 0);
+    while(count != 0){
+        command_response[response_length++] = digits[--count];
+    }
+}
+
+static void cdc_command_usage(const cdc_command_t *command){
+    cdc_usb_segment_t response[] = {
+        { CDC_COMMAND_USAGE_PREFIX, sizeof(CDC_COMMAND_USAGE_PREFIX) - 1 },
+        { command->usage, (command->usage != NULL) ? strlen(command->usage) : 0 },
+        { "\r\n", 2 },
+    };
+    cdc_usb_write_segments(response, 3, NULL, NULL);
+}
+
+/**
+ * @brief Run one command
+ *
+ * In interactive mode the failures are answered here; in machine mode the
+ * caller adds the result to the response.
+ */
+static cdc_command_result_t cdc_command_run(char *text){
+    cdc_command_args_t args;
+    uint8_t argc = cdc_command_tokenize(text, args.argv);
+    if(argc == 0){
+        return CDC_COMMAND_EMPTY;
+    }
+    const cdc_command_t *command = cdc_command_find(args.argv[0]);
+    if(command == NULL){
+        if(line_mode == CDC_COMMAND_MODE_INTERACTIVE){
+            cdc_usb_write_buffer(CDC_COMMAND_UNKNOWN_RESPONSE, sizeof(CDC_COMMAND_UNKNOWN_RESPONSE) - 1, NULL, NULL);
+        }
+        return CDC_COMMAND_UNKNOWN;
+    }
+    args.argc = argc;
+    if(argc > CDC_COMMAND_MAX_ARGS || !command->handler(&args)){
+        if(line_mode == CDC_COMMAND_MODE_INTERACTIVE){
+            cdc_command_usage(command);
+        }
+        return CDC_COMMAND_USAGE;
+    }
+    return CDC_COMMAND_OK;
+}
+
+cdc_command_result_t cdc_command_dispatch(char *line){
+    if(line == NULL){
+        return CDC_COMMAND_EMPTY;
+    }
+    line_mode = command_mode;
+    if(line_mode == CDC_COMMAND_MODE_INTERACTIVE){
+        return cdc_command_run(line);
+    }
+
+    cdc_command_result_t status = CDC_COMMAND_EMPTY;
+    command_response[0] = CDC_COMMAND_RESPONSE_START;
+    response_length = 1;
+    response_data = 0;
+    cdc_command_append_number((uint16_t)(cdc_usb_line_number() - sequence_base));
+    uint16_t header = response_length;
+    while(line != NULL){
+        char *separator = strchr(line, CDC_COMMAND_SEPARATOR);
+        if(separator != NULL){
+            *separator++ = '\0';
+        }
+        // The result goes in before the handler runs so that its data lands
+        // after it; the digit is patched once the result is known
+        uint16_t start = response_length;
+        cdc_command_append((start == header) ? " 0" : ";0", 2);
+        cdc_command_result_t result = cdc_command_run(line);
+        if(result == CDC_COMMAND_EMPTY){
+            response_length = start;
+        } else {
+            command_response[start + 1] = '0' + result;
+            if(status == CDC_COMMAND_EMPTY || status == CDC_COMMAND_OK){
+                status = result;
+            }
+        }
+        line = separator;
+    }
+    if(status != CDC_COMMAND_EMPTY){
+        cdc_command_append("\r\n", 2);
+        cdc_usb_write_bytes(command_response, response_length);
+    }
+    return status;
+}
+
+bool cdc_command_respond(const char *text){
+    if(text == NULL){
+        return false;
+    }
+    size_t length = strlen(text);
+    if(line_mode == CDC_COMMAND_MODE_INTERACTIVE){
+        return cdc_usb_write_buffer("\r\n", 2, NULL, NULL) &&
+               (length == 0 || cdc_usb_write_bytes(text, length)) &&
+               cdc_usb_write_buffer("\r\n", 2, NULL, NULL);
+    }
+    if(length + 1 > CDC_COMMAND_RESPONSE_DATA_MAX - response_data){
+        return false;
+    }
+    response_data += length + 1;
+    return cdc_command_append(" ", 1) && cdc_command_append(text, length);
+}
+
+void cdc_command_set_mode(cdc_command_mode_t mode){
+    command_mode = mode;
+    // The line being dispatched is still answered in the old mode
+    sequence_base = cdc_usb_line_number() + 1;
+    cdc_usb_set_echo(mode == CDC_COMMAND_MODE_INTERACTIVE);
+}
+
+cdc_command_mode_t cdc_command_get_mode(void){
+    return command_mode;
+}
+
+/**
+ * @brief Parse an optional sign
+ *
+ * @return Text after the sign
+ */
+static const char* cdc_command_sign(const char *text, bool *negative){
+    *negative = (*text == '-');
+    if(*text == '-' || *text == '+'){
+        text++;
+    }
+    return text;
+}
+
+/**
+ * @brief Apply the sign to a magnitude of at most 2^31
+ */
+static bool cdc_command_signed(uint64_t magnitude, bool negative, int32_t *value){
+    if(magnitude > (negative ? 0x80000000ULL : 0x7FFFFFFFULL)){
+        return false;
+    }
+    *value = negative ? (int32_t)(0 - (uint32_t)magnitude) : (int32_t)magnitude;
+    return true;
+}
+
+bool cdc_command_parse_int(const char *text, int32_t *value){
+    bool negative;
+    uint64_t magnitude = 0;
+    if(text == NULL || value == NULL){
+        return false;
+    }
+    text = cdc_command_sign(text, &negative);
+    if(text[0] == '0' && (text[1] == 'x' || text[1] == 'X')){
+        text += 2;
+        if(*text == '\0'){
+            return false;
+        }
+        for(; *text != '\0'; text++){
+            uint8_t digit;
+            if(*text >= '0' && *text <= '9'){
+                digit = *text - '0';
+            } else if(*text >= 'a' && *text <= 'f'){
+                digit = *text - 'a' + 10;
+            } else if(*text >= 'A' && *text <= 'F'){
+                digit = *text - 'A' + 10;
+            } else {
+                return false;
+            }
+            magnitude = (magnitude << 4) | digit;
+            if(magnitude > 0x80000000ULL){
+                return false;
+            }
+        }
+    } else {
+        if(*text == '\0'){
+            return false;
+        }
+        for(; *text != '\0'; text++){
+            if(*text < '0' || *text > '9'){
+                return false;
+            }
+            magnitude = magnitude * 10 + (uint8_t)(*text - '0');
+            if(magnitude > 0x80000000ULL){
+                return false;
+            }
+        }
+    }
+    return cdc_command_signed(magnitude, negative, value);
+}
+
+bool cdc_command_parse_fixed(const char *text, uint8_t decimals, int32_t *value){
+    bool negative;
+    bool digits = false;
+    uint64_t magnitude = 0;
+    uint8_t fraction = 0;
+    if(text == NULL || value == NULL || decimals > 9){
+        return false;
+    }
+    text = cdc_command_sign(text, &negative);
+    for(; *text >= '0' && *text <= '9'; text++){
+        magnitude = magnitude * 10 + (uint8_t)(*text - '0');
+        if(magnitude > 0x80000000ULL){
+            return false;
+        }
+        digits = true;
+    }
+    if(*text == '.'){
+        text++;
+        for(; *text >= '0' && *text <= '9'; text++){
+            if(fraction < decimals){
+                magnitude = magnitude * 10 + (uint8_t)(*text - '0');
+                fraction++;
+            } else if(fraction == decimals){
+                magnitude += (*text >= '5');   // Round on the first dropped digit
+                fraction++;
+            }
+            digits = true;
+        }
+    }
+    if(!digits || *text != '\0'){
+        return false;
+    }
+    for(; fraction < decimals; fraction++){
+        magnitude *= 10;
+        if(magnitude > 0x80000000ULL){
+            return false;
+        }
+    }
+    return cdc_command_signed(magnitude, negative, value);
+}
+
+bool cdc_command_arg_int(const cdc_command_args_t *args, uint8_t index,
+                         int32_t min, int32_t max, int32_t *value){
+    int32_t parsed;
+    if(args == NULL || index >= args->argc || !cdc_command_parse_int(args->argv[index], &parsed)){
+        return false;
+    }
+    if(parsed < min || parsed > max){
+        return false;
+    }
+    *value = parsed;
+    return true;
+}
+
+bool cdc_command_arg_fixed(const cdc_command_args_t *args, uint8_t index, uint8_t decimals,
+                           int32_t min, int32_t max, int32_t *value){
+    int32_t parsed;
+    if(args == NULL || index >= args->argc || !cdc_command_parse_fixed(args->argv[index], decimals, &parsed)){
+        return false;
+    }
+    if(parsed < min || parsed > max){
+        return false;
+    }
+    *value = parsed;
+    return true;
+}
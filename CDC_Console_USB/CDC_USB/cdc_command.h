@@ -0,0 +1,286 @@
+/**
+ * @file cdc_command.h
+ * @brief Table-driven command dispatcher for the CDC console
+ *
+ * This module splits a received console line into whitespace separated
+ * tokens, looks the first token up among the registered commands and calls
+ * the command handler with the remaining tokens as arguments.
+ *
+ * Commands are declared in const tables with CDC_COMMAND(), so names and
+ * usage texts stay in flash. The hash of every name is computed by the
+ * compiler; registering a table only places the entries into an open
+ * addressing index, and a lookup costs one hash of the token and usually a
+ * single string compare, however many commands are registered.
+ *
+ * Integer and fixed-point arguments are parsed without sscanf().
+ *
+ * In machine mode the console is meant for scripts: nothing is echoed,
+ * a line may hold several commands separated by ';' and the whole line is
+ * answered with a single terse status line carrying a sequence number.
+ *
+ * @author Alejandro Beltran
+ * @date October 2026
+ */
+
+#ifndef _CDC_COMMAND_H
+#define _CDC_COMMAND_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+extern "C" {
+#endif
+// DOM-IGNORE-END
+
+//! @brief Longest command name in characters
+#define CDC_COMMAND_NAME_MAX 16
+//! @brief Most tokens on a line, command name included
+#define CDC_COMMAND_MAX_ARGS 8
+//! @brief log2 of the index size; the index holds up to 2^bits - 1 commands
+#define CDC_COMMAND_INDEX_BITS 8
+//! @brief Response to a line whose first token is not a command
+#define CDC_COMMAND_UNKNOWN_RESPONSE "\r\nUnknown command\r\n"
+//! @brief Text sent before the usage of a command called with bad arguments
+#define CDC_COMMAND_USAGE_PREFIX "\r\nUsage: "
+//! @brief Separator of the commands of a machine mode line
+#define CDC_COMMAND_SEPARATOR ';'
+//! @brief First character of a machine mode response
+#define CDC_COMMAND_RESPONSE_START '='
+//! @brief Most bytes of handler data in one machine mode response
+#define CDC_COMMAND_RESPONSE_DATA_MAX 128
+
+//! @brief Character of a name literal, 0 past its end
+#define CDC_COMMAND_CHAR(s, i) \
+    ((uint32_t)((i) < sizeof(s) - 1 ? (uint8_t)(s)[(i) < sizeof(s) - 1 ? (i) : 0] : 0))
+//! @brief Hash weight of the character at position i
+#define CDC_COMMAND_WEIGHT(i) ((2u * (uint32_t)(i) + 1u) * 0x9E3779B1u)
+#define CDC_COMMAND_TERM(s, i) (CDC_COMMAND_CHAR(s, i) * CDC_COMMAND_WEIGHT(i))
+
+/**
+ * @brief Hash of a command name literal, evaluated by the compiler
+ *
+ * A weighted sum of the first CDC_COMMAND_NAME_MAX characters and the
+ * length; cdc_command_dispatch() computes the same value for the received
+ * token.
+ */
+#define CDC_COMMAND_HASH(s) ((uint32_t)(sizeof(s) - 1) * 0x85EBCA6Bu + \
+    CDC_COMMAND_TERM(s, 0) + CDC_COMMAND_TERM(s, 1) + CDC_COMMAND_TERM(s, 2) + CDC_COMMAND_TERM(s, 3) + \
+    CDC_COMMAND_TERM(s, 4) + CDC_COMMAND_TERM(s, 5) + CDC_COMMAND_TERM(s, 6) + CDC_COMMAND_TERM(s, 7) + \
+    CDC_COMMAND_TERM(s, 8) + CDC_COMMAND_TERM(s, 9) + CDC_COMMAND_TERM(s, 10) + CDC_COMMAND_TERM(s, 11) + \
+    CDC_COMMAND_TERM(s, 12) + CDC_COMMAND_TERM(s, 13) + CDC_COMMAND_TERM(s, 14) + CDC_COMMAND_TERM(s, 15))
+
+/**
+ * @brief Declares a command table entry
+ *
+ * @param name Command name literal (at most CDC_COMMAND_NAME_MAX characters)
+ * @param handler Function called with the tokens of the line
+ * @param usage Usage text literal, sent when the handler rejects its arguments
+ */
+#define CDC_COMMAND(name, handler, usage) { name, CDC_COMMAND_HASH(name), handler, usage }
+
+/**
+ * @brief Tokens of a command line
+ */
+typedef struct
+{
+    /** @brief Number of tokens, command name included */
+    uint8_t argc;
+    /** @brief Tokens; argv[0] is the command name */
+    char * argv[CDC_COMMAND_MAX_ARGS];
+} cdc_command_args_t;
+
+/**
+ * @brief Command handler
+ *
+ * @param args Tokens of the line
+ * @return false if the arguments are invalid, the usage text is then sent
+ */
+typedef bool (*cdc_command_handler_t)(const cdc_command_args_t *args);
+
+/**
+ * @brief Command table entry, declare with CDC_COMMAND()
+ */
+typedef struct
+{
+    /** @brief Command name */
+    const char * name;
+    /** @brief CDC_COMMAND_HASH() of the name */
+    uint32_t hash;
+    /** @brief Handler called with the tokens of the line */
+    cdc_command_handler_t handler;
+    /** @brief Usage text */
+    const char * usage;
+} cdc_command_t;
+
+/**
+ * @brief Result of cdc_command_dispatch()
+ */
+typedef enum
+{
+    /** @brief The command ran */
+    CDC_COMMAND_OK = 0,
+    /** @brief The line holds no token */
+    CDC_COMMAND_EMPTY,
+    /** @brief The first token is not a registered command */
+    CDC_COMMAND_UNKNOWN,
+    /** @brief Too many tokens or the handler rejected its arguments */
+    CDC_COMMAND_USAGE
+} cdc_command_result_t;
+
+/**
+ * @brief Console modes
+ */
+typedef enum
+{
+    /** @brief Echo, human readable responses, one command per line */
+    CDC_COMMAND_MODE_INTERACTIVE = 0,
+    /** @brief No echo, batched commands, one status line per line */
+    CDC_COMMAND_MODE_MACHINE
+} cdc_command_mode_t;
+
+/**
+ * @brief Registers a table of commands
+ *
+ * The table is not copied and must stay valid; a const table in flash is
+ * the intended use. Several tables may be registered, e.g. one per module.
+ *
+ * @param commands Table of entries declared with CDC_COMMAND()
+ * @param count Number of entries
+ * @return true if all the entries were registered
+ * @return false if a name is too long or already registered, a hash does not
+ *               match its name, or the index is full; the entries before the
+ *               failing one stay registered
+ */
+bool cdc_command_register(const cdc_command_t *commands, uint16_t count);
+
+/**
+ * @brief Runs the command of a line
+ *
+ * The line is split in place into tokens separated by spaces or tabs. An
+ * unknown command is answered with CDC_COMMAND_UNKNOWN_RESPONSE, a rejected
+ * call with CDC_COMMAND_USAGE_PREFIX followed by the usage text.
+ *
+ * In machine mode the line is first split on CDC_COMMAND_SEPARATOR and the
+ * commands run in order; a failing command does not stop the following
+ * ones. The line is then answered with
+ *
+ *     =<sequence> <result>[ <data>][;<result>[ <data>]]...\r\n
+ *
+ * where result is the cdc_command_result_t value of each command and data
+ * is what its handler passed to cdc_command_respond(). The sequence number
+ * is the number of the received line (cdc_usb_line_number()) counted from
+ * 0 since machine mode was entered, so the host can send several lines
+ * before reading their responses. Lines without any command get no
+ * response, and lines discarded as too long are answered with
+ * CDC_USB_LINE_OVERFLOW_RESPONSE only; both still take a number, so the
+ * gap they leave in the sequence shows which line went unanswered.
+ *
+ * @param line Null-terminated line, modified by the tokenizer
+ * @return cdc_command_result_t CDC_COMMAND_OK if every command ran, else the
+ *         first failure
+ */
+cdc_command_result_t cdc_command_dispatch(char *line);
+
+/**
+ * @brief Sends the result of a command
+ *
+ * To be called from handlers instead of writing to the console, so that
+ * the output follows the mode of the line: in interactive mode the text is
+ * sent on its own line, in machine mode it is added after the result of
+ * the command in the combined response.
+ *
+ * @param text Null-terminated text; in machine mode it should contain
+ *             neither CDC_COMMAND_SEPARATOR nor line breaks
+ * @return false if the text could not be queued, or would take the handler
+ *         data of the machine mode response over CDC_COMMAND_RESPONSE_DATA_MAX
+ */
+bool cdc_command_respond(const char *text);
+
+/**
+ * @brief Selects the console mode
+ *
+ * Entering machine mode disables the echo (cdc_usb_set_echo()) and restarts
+ * the sequence numbers; interactive mode enables the echo again. A line
+ * that changes the mode is still answered in the mode it started in.
+ *
+ * @param mode CDC_COMMAND_MODE_INTERACTIVE or CDC_COMMAND_MODE_MACHINE
+ */
+void cdc_command_set_mode(cdc_command_mode_t mode);
+
+/**
+ * @brief Gets the console mode
+ *
+ * @return cdc_command_mode_t Current mode
+ */
+cdc_command_mode_t cdc_command_get_mode(void);
+
+/**
+ * @brief Finds a registered command by name
+ *
+ * @param name Null-terminated command name
+ * @return const cdc_command_t* Entry of the command, NULL if not registered
+ */
+const cdc_command_t* cdc_command_find(const char *name);
+
+/**
+ * @brief Parses a signed integer
+ *
+ * Accepts an optional sign followed by decimal digits, or by 0x and
+ * hexadecimal digits. The whole text must be consumed.
+ *
+ * @param text Null-terminated text
+ * @param value Receives the parsed value
+ * @return false if the text is not an integer or does not fit in 32 bits
+ */
+bool cdc_command_parse_int(const char *text, int32_t *value);
+
+/**
+ * @brief Parses a decimal number into fixed point
+ *
+ * "1.25" with 3 decimals gives 1250. Digits beyond the requested decimals
+ * are rounded half away from zero.
+ *
+ * @param text Null-terminated text with an optional sign and decimal point
+ * @param decimals Number of decimals of the result (0 to 9)
+ * @param value Receives the scaled value
+ * @return false if the text is not a number or the result does not fit in 32 bits
+ */
+bool cdc_command_parse_fixed(const char *text, uint8_t decimals, int32_t *value);
+
+/**
+ * @brief Parses an integer argument within a range
+ *
+ * @param args Tokens passed to the handler
+ * @param index Token index (1 for the first argument)
+ * @param min Smallest accepted value
+ * @param max Largest accepted value
+ * @param value Receives the parsed value
+ * @return false if the token is missing, not an integer or out of range
+ */
+bool cdc_command_arg_int(const cdc_command_args_t *args, uint8_t index,
+                         int32_t min, int32_t max, int32_t *value);
+
+/**
+ * @brief Parses a fixed-point argument within a range
+ *
+ * @param args Tokens passed to the handler
+ * @param index Token index (1 for the first argument)
+ * @param decimals Number of decimals of the result (0 to 9)
+ * @param min Smallest accepted scaled value
+ * @param max Largest accepted scaled value
+ * @param value Receives the scaled value
+ * @return false if the token is missing, not a number or out of range
+ */
+bool cdc_command_arg_fixed(const cdc_command_args_t *args, uint8_t index, uint8_t decimals,
+                           int32_t min, int32_t max, int32_t *value);
+
+//DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+}
+#endif
+//DOM-IGNORE-END
+
+#endif /* _CDC_COMMAND_H */
@@ -0,0 +1,180 @@
+/**
+ * @file cdc_format.c
+ * @brief Implementation of the printf-free formatters
+ *
+ * Digits are produced least significant first into a small scratch buffer
+ * and copied once the length is known, so a number that does not fit
+ * leaves the destination untouched.
+ *
+ * @author Alejandro Beltran
+ * @date October 2026
+ */
+
+#include "cdc_format.h"
+#include "cdc_usb_platform.h"
+
+#include <string.h>
+
+static const char format_hex_digits[] = "0123456789ABCDEF";
+
+/**
+ * @brief Writes the decimal digits of value backwards, ending at end
+ *
+ * @param end One past the last digit
+ * @param digits Least number of digits, padded with zeros
+ * @return char* First digit
+ */
+static char* cdc_format_digits(char *end, uint32_t value, uint8_t digits){
+    char *start = end;
+    do {
+        *--start = (char)('0' + value % 10U);
+        value /= 10U;
+    } while(value != 0);
+    while(end - start < digits){
+        *--start = '0';
+    }
+    return start;
+}
+
+static size_t cdc_format_copy(char *buffer, size_t size, const char *start, const char *end){
+    size_t length = (size_t)(end - start);
+    if(buffer == NULL || length > size){
+        return 0;
+    }
+    memcpy(buffer, start, length);
+    return length;
+}
+
+size_t cdc_format_uint(char *buffer, size_t size, uint32_t value){
+    char digits[CDC_FORMAT_NUMBER_MAX];
+    char *end = digits + sizeof(digits);
+    return cdc_format_copy(buffer, size, cdc_format_digits(end, value, 0), end);
+}
+
+size_t cdc_format_int(char *buffer, size_t size, int32_t value){
+    return cdc_format_fixed(buffer, size, value, 0);
+}
+
+size_t cdc_format_hex(char *buffer, size_t size, uint32_t value, uint8_t digits){
+    char text[8];
+    char *end = text + sizeof(text);
+    char *start = end;
+    if(digits > sizeof(text)){
+        digits = sizeof(text);
+    }
+    do {
+        *--start = format_hex_digits[value & 0x0FU];
+        value >>= 4;
+    } while(value != 0);
+    while(end - start < digits){
+        *--start = '0';
+    }
+    return cdc_format_copy(buffer, size, start, end);
+}
+
+size_t cdc_format_fixed(char *buffer, size_t size, int32_t value, uint8_t decimals){
+    static const uint32_t scale[CDC_FORMAT_DECIMALS_MAX + 1] = {
+        1U, 10U, 100U, 1000U, 10000U, 100000U, 1000000U, 10000000U, 100000000U, 1000000000U
+    };
+    char text[CDC_FORMAT_NUMBER_MAX];
+    char *end = text + sizeof(text);
+    char *start = end;
+    // Negate as unsigned so that INT32_MIN works too
+    uint32_t magnitude = (value < 0) ? 0U - (uint32_t)value : (uint32_t)value;
+    if(decimals > CDC_FORMAT_DECIMALS_MAX){
+        return 0;
+    }
+    if(decimals > 0){
+        start = cdc_format_digits(end, magnitude % scale[decimals], decimals);
+        *--start = '.';
+    }
+    start = cdc_format_digits(start, magnitude / scale[decimals], 0);
+    if(value < 0){
+        *--start = '-';
+    }
+    return cdc_format_copy(buffer, size, start, end);
+}
+
+void cdc_format_line_init(cdc_format_line_t *line, char *buffer, size_t size){
+    line->buffer = buffer;
+    line->size = size;
+    line->length = 0;
+    line->overflow = (buffer == NULL || size == 0);
+}
+
+/**
+ * @brief Space left in the line, keeping room for the terminating NUL
+ */
+static size_t cdc_format_line_space(const cdc_format_line_t *line){
+    return line->overflow ? 0 : line->size - 1 - line->length;
+}
+
+/**
+ * @brief Accounts for an append of written characters, 0 meaning it failed
+ */
+static bool cdc_format_line_advance(cdc_format_line_t *line, size_t written){
+    if(written == 0){
+        line->overflow = true;
+        return false;
+    }
+    line->length += written;
+    return true;
+}
+
+bool cdc_format_line_str(cdc_format_line_t *line, const char *text){
+    if(text == NULL){
+        return !line->overflow;
+    }
+    size_t length = strlen(text);
+    if(line->overflow || length > cdc_format_line_space(line)){
+        line->overflow = true;
+        return false;
+    }
+    memcpy(&line->buffer[line->length], text, length);
+    line->length += length;
+    return true;
+}
+
+bool cdc_format_line_char(cdc_format_line_t *line, char character){
+    if(cdc_format_line_space(line) == 0){
+        line->overflow = true;
+        return false;
+    }
+    line->buffer[line->length++] = character;
+    return true;
+}
+
+bool cdc_format_line_uint(cdc_format_line_t *line, uint32_t value){
+    size_t space = cdc_format_line_space(line);
+    return cdc_format_line_advance(line, cdc_format_uint(&line->buffer[line->length], space, value));
+}
+
+bool cdc_format_line_int(cdc_format_line_t *line, int32_t value){
+    size_t space = cdc_format_line_space(line);
+    return cdc_format_line_advance(line, cdc_format_int(&line->buffer[line->length], space, value));
+}
+
+bool cdc_format_line_hex(cdc_format_line_t *line, uint32_t value, uint8_t digits){
+    size_t space = cdc_format_line_space(line);
+    return cdc_format_line_advance(line, cdc_format_hex(&line->buffer[line->length], space, value, digits));
+}
+
+bool cdc_format_line_fixed(cdc_format_line_t *line, int32_t value, uint8_t decimals){
+    size_t space = cdc_format_line_space(line);
+    return cdc_format_line_advance(line, cdc_format_fixed(&line->buffer[line->length], space, value, decimals));
+}
+
+const char* cdc_format_line_text(cdc_format_line_t *line){
+    if(line->buffer == NULL || line->size == 0){
+        return "";
+    }
+    line->buffer[line->length] = '\0';
+    return line->buffer;
+}
+
+bool cdc_format_line_write(cdc_format_line_t *line){
+    if(line->overflow){
+        return false;
+    }
+    return line->length == 0 || cdc_usb_write_bytes(line->buffer, line->length);
+}
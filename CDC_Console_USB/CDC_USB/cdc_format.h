@@ -0,0 +1,186 @@
+/**
+ * @file cdc_format.h
+ * @brief Number formatting and line building without printf
+ *
+ * The console only needs decimal, hexadecimal and fixed-point numbers, so
+ * these formatters replace sprintf() and keep newlib's printf family, and
+ * its floating point support, out of the image.
+ *
+ * The cdc_format_uint(), cdc_format_int(), cdc_format_hex() and
+ * cdc_format_fixed() functions write the digits of one number into a
+ * caller's buffer. They write all the characters or none, and never a
+ * terminating NUL, so they can fill a field of a larger buffer.
+ *
+ * A cdc_format_line_t assembles a line from text and numbers in a caller's
+ * buffer. An append that does not fit sets the overflow flag and leaves the
+ * line as it was; further appends are ignored, so a sequence of appends
+ * needs one check at the end.
+ *
+ * @code
+ * char buffer[32];
+ * cdc_format_line_t line;
+ * cdc_format_line_init(&line, buffer, sizeof(buffer));
+ * cdc_format_line_str(&line, "vin ");
+ * cdc_format_line_fixed(&line, millivolts, 3);    // 3300 -> "3.300"
+ * cdc_format_line_str(&line, " V\r\n");
+ * cdc_format_line_write(&line);
+ * @endcode
+ *
+ * @author Alejandro Beltran
+ * @date October 2026
+ */
+
+#ifndef _CDC_FORMAT_H
+#define _CDC_FORMAT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+extern "C" {
+#endif
+// DOM-IGNORE-END
+
+//! @brief Longest formatted number: sign, 10 digits and a decimal point
+#define CDC_FORMAT_NUMBER_MAX 12
+//! @brief Most decimals of a fixed-point number
+#define CDC_FORMAT_DECIMALS_MAX 9
+
+/**
+ * @brief Line being assembled in a caller's buffer
+ */
+typedef struct
+{
+    /** @brief Buffer holding the line */
+    char * buffer;
+    /** @brief Size of the buffer, including the terminating NUL */
+    size_t size;
+    /** @brief Characters in the line */
+    size_t length;
+    /** @brief An append did not fit */
+    bool overflow;
+} cdc_format_line_t;
+
+/**
+ * @brief Writes an unsigned decimal number
+ *
+ * @param buffer Destination, not NUL terminated
+ * @param size Space in buffer
+ * @param value Number to write
+ * @return size_t Characters written, 0 if they do not fit
+ */
+size_t cdc_format_uint(char *buffer, size_t size, uint32_t value);
+
+/**
+ * @brief Writes a signed decimal number
+ *
+ * @param buffer Destination, not NUL terminated
+ * @param size Space in buffer
+ * @param value Number to write
+ * @return size_t Characters written, 0 if they do not fit
+ */
+size_t cdc_format_int(char *buffer, size_t size, int32_t value);
+
+/**
+ * @brief Writes a hexadecimal number in upper case, without prefix
+ *
+ * @param buffer Destination, not NUL terminated
+ * @param size Space in buffer
+ * @param value Number to write
+ * @param digits Least number of digits, padded with zeros (at most 8)
+ * @return size_t Characters written, 0 if they do not fit
+ */
+size_t cdc_format_hex(char *buffer, size_t size, uint32_t value, uint8_t digits);
+
+/**
+ * @brief Writes a scaled integer as a fixed-point decimal number
+ *
+ * The value is in units of 10^-decimals and is written with exactly that
+ * many decimals, e.g. 3300 with 3 decimals as "3.300" and -5 as "-0.005".
+ *
+ * @param buffer Destination, not NUL terminated
+ * @param size Space in buffer
+ * @param value Scaled number to write
+ * @param decimals Digits after the decimal point (at most
+ *                 CDC_FORMAT_DECIMALS_MAX, 0 writes an integer)
+ * @return size_t Characters written, 0 if they do not fit or decimals is
+ *         too large
+ */
+size_t cdc_format_fixed(char *buffer, size_t size, int32_t value, uint8_t decimals);
+
+/**
+ * @brief Starts an empty line
+ *
+ * @param line Line to start
+ * @param buffer Buffer for the line
+ * @param size Size of the buffer, at least 1 for the terminating NUL
+ */
+void cdc_format_line_init(cdc_format_line_t *line, char *buffer, size_t size);
+
+/**
+ * @brief Appends a string
+ *
+ * @return false if the line has overflowed
+ */
+bool cdc_format_line_str(cdc_format_line_t *line, const char *text);
+
+/**
+ * @brief Appends a character
+ *
+ * @return false if the line has overflowed
+ */
+bool cdc_format_line_char(cdc_format_line_t *line, char character);
+
+/**
+ * @brief Appends an unsigned decimal number, see cdc_format_uint()
+ *
+ * @return false if the line has overflowed
+ */
+bool cdc_format_line_uint(cdc_format_line_t *line, uint32_t value);
+
+/**
+ * @brief Appends a signed decimal number, see cdc_format_int()
+ *
+ * @return false if the line has overflowed
+ */
+bool cdc_format_line_int(cdc_format_line_t *line, int32_t value);
+
+/**
+ * @brief Appends a hexadecimal number, see cdc_format_hex()
+ *
+ * @return false if the line has overflowed
+ */
+bool cdc_format_line_hex(cdc_format_line_t *line, uint32_t value, uint8_t digits);
+
+/**
+ * @brief Appends a fixed-point number, see cdc_format_fixed()
+ *
+ * @return false if the line has overflowed or decimals is too large
+ */
+bool cdc_format_line_fixed(cdc_format_line_t *line, int32_t value, uint8_t decimals);
+
+/**
+ * @brief Terminates the line
+ *
+ * @return const char* The NUL terminated line, holding the appends made
+ *         before an overflow
+ */
+const char* cdc_format_line_text(cdc_format_line_t *line);
+
+/**
+ * @brief Queues the line for transmission with cdc_usb_write_bytes()
+ *
+ * @return false if the line has overflowed or the transmit ring is full;
+ *         nothing is sent in either case
+ */
+bool cdc_format_line_write(cdc_format_line_t *line);
+
+//DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+}
+#endif
+//DOM-IGNORE-END
+
+#endif /* _CDC_FORMAT_H */
@@ -0,0 +1,132 @@
+/**
+ * @file cdc_frame.h
+ * @brief Binary framing layer sharing the CDC data endpoint with the console
+ *
+ * This module sends binary payloads, such as raw ADC sample buffers, as
+ * COBS encoded frames interleaved with the text of the console. Text never
+ * contains a zero byte, so zero is used as the escape byte: every frame is
+ * sent as
+ *
+ *     0x00 COBS(channel, sequence, payload..., crc_lo, crc_hi) 0x00
+ *
+ * and the host reads text until a zero byte, then a frame until the next
+ * zero byte. A frame is queued as one transmit ring record, so it is never
+ * split by text written at the same time.
+ *
+ * - channel: Typed stream the payload belongs to (0 to CDC_FRAME_CHANNELS - 1)
+ * - sequence: Per channel counter, incremented for every frame queued
+ * - crc: CRC-16/CCITT-FALSE (polynomial 0x1021, initial value 0xFFFF) of the
+ *   channel, sequence and payload bytes, little-endian
+ *
+ * The payload is encoded straight from the caller's buffers into one of
+ * CDC_FRAME_BUFFERS frame buffers, computing the CRC in the same pass, and
+ * the frame buffer is queued without a further copy. The caller's buffers
+ * may be reused as soon as the call returns.
+ *
+ * @author Alejandro Beltran
+ * @date October 2026
+ */
+
+#ifndef _CDC_FRAME_H
+#define _CDC_FRAME_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "cdc_usb_platform.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+extern "C" {
+#endif
+// DOM-IGNORE-END
+
+//! @brief Largest payload of one frame in bytes
+#define CDC_FRAME_PAYLOAD_MAX 512
+//! @brief Number of channels
+#define CDC_FRAME_CHANNELS 16
+//! @brief Frame buffers; one is encoded while the others wait for USB
+#define CDC_FRAME_BUFFERS 3
+//! @brief Frame buffers bulk producers leave free for telemetry and the log
+#define CDC_FRAME_RESERVED 1
+//! @brief Escape byte starting and ending a frame in the console stream
+#define CDC_FRAME_DELIMITER 0x00
+//! @brief Channel and sequence bytes before the payload
+#define CDC_FRAME_HEADER_SIZE 2
+//! @brief CRC bytes after the payload
+#define CDC_FRAME_CRC_SIZE 2
+
+/**
+ * @brief Bytes sent for a payload of n bytes in the worst case
+ *
+ * COBS adds one code byte per 254 bytes of input (rounded up), and the frame
+ * is enclosed in two delimiters.
+ */
+#define CDC_FRAME_ENCODED_SIZE(n) \
+    ((n) + CDC_FRAME_HEADER_SIZE + CDC_FRAME_CRC_SIZE + \
+     ((n) + CDC_FRAME_HEADER_SIZE + CDC_FRAME_CRC_SIZE) / 254 + 1 + 2)
+
+/**
+ * @brief Sends a payload as one frame
+ *
+ * @param channel Channel of the payload
+ * @param payload Payload bytes, sent as they are in memory
+ * @param length Payload length (0 to CDC_FRAME_PAYLOAD_MAX)
+ * @return true if the frame was queued
+ * @return false if the arguments are invalid, every frame buffer is still
+ *               in use, the device is not configured or the transmit ring is
+ *               full; the sequence number of the channel is then unchanged
+ * @note One producer per channel keeps the sequence numbers in order
+ */
+bool cdc_frame_send(uint8_t channel, const void *payload, size_t length);
+
+/**
+ * @brief Sends the concatenation of several buffers as one frame
+ *
+ * Useful to put a small header in front of a sample buffer without copying
+ * the samples first.
+ *
+ * @param channel Channel of the payload
+ * @param segments Buffers forming the payload, in order
+ * @param count Number of buffers
+ * @return Same as cdc_frame_send(); false as well if the buffers add up to
+ *         more than CDC_FRAME_PAYLOAD_MAX bytes
+ */
+bool cdc_frame_send_segments(uint8_t channel, const cdc_usb_segment_t *segments, uint8_t count);
+
+/**
+ * @brief Tells whether a frame can be sent right now
+ *
+ * @return true if a frame buffer is free
+ */
+bool cdc_frame_ready(void);
+
+/**
+ * @brief Counts the frame buffers not waiting for USB
+ *
+ * A bulk producer such as a sample stream sends only while more than
+ * CDC_FRAME_RESERVED buffers are free, so it cannot hold every buffer and
+ * the short periodic frames still find one.
+ *
+ * @return Number of free frame buffers
+ */
+uint8_t cdc_frame_free(void);
+
+/**
+ * @brief Computes the CRC used by the frames
+ *
+ * @param crc Previous value, 0xFFFF for the first block
+ * @param data Bytes to add
+ * @param length Number of bytes
+ * @return uint16_t Updated CRC-16/CCITT-FALSE
+ */
+uint16_t cdc_frame_crc(uint16_t crc, const void *data, size_t length);
+
+//DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+}
+#endif
+//DOM-IGNORE-END
+
+#endif /* _CDC_FRAME_H */
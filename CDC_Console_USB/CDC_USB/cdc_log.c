@@ -0,0 +1,144 @@
+/**
+ * @file cdc_log.c
+ * @brief Implementation of the deferred binary logger
+ *
+ * The ring is indexed by free-running word counters. A producer reserves
+ * its words by advancing head with a compare-and-swap, writes the timestamp
+ * and arguments, and commits the record by storing the header last. The
+ * drain stops at the first header without CDC_LOG_VALID, so a record that
+ * is still being written holds back the ones after it, and clears the
+ * words it has sent so that stale data is never taken for a header.
+ *
+ * The epoch and the cycle count at which cdc_log_task() last saw it are
+ * packed in one word, read by log calls without a lock: a cycle count below
+ * the one in the word means the counter has wrapped once more since.
+ *
+ * @author Alejandro Beltran
+ * @date October 2026
+ */
+
+#include "cdc_log.h"
+#include "cdc_frame.h"
+#include "cdc_usb_platform.h"
+
+#define CDC_LOG_MASK (CDC_LOG_RING_WORDS - 1U)
+#define CDC_LOG_COUNT(header) (((header) >> 16) & 0x0FU)
+#define CDC_LOG_FRAME_WORDS (CDC_FRAME_PAYLOAD_MAX / sizeof(uint32_t))
+#define CDC_LOG_EPOCH_SHIFT 20
+#define CDC_LOG_EPOCH_MASK 0x7FFU
+// Clock word: epoch in bits 21-31, cycles >> 11 in bits 0-20
+#define CDC_LOG_CLOCK_CYCLES(cycles) ((cycles) >> 11)
+#define CDC_LOG_CLOCK_MASK 0x1FFFFFU
+
+static struct {
+    uint32_t words[CDC_LOG_RING_WORDS];
+    uint32_t head;          // Next word to reserve, advanced by the producers
+    uint32_t tail;          // Next word to send, advanced by cdc_log_task()
+    uint32_t dropped;       // Records dropped since start
+    uint32_t reported;      // Dropped records already reported to the host
+    uint32_t clock;         // Epoch and last cycle count seen by cdc_log_task()
+    bool output;            // Records are sent by cdc_log_task()
+} cdcLog;
+
+static uint32_t cdcLogFrame[CDC_LOG_FRAME_WORDS];
+
+void cdc_log_initialize(void){
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    __atomic_store_n(&cdcLog.clock, 0, __ATOMIC_RELAXED);
+    cdcLog.output = false;
+}
+
+/**
+ * @brief Epoch of a cycle count read after the last cdc_log_clock() update
+ */
+static uint32_t cdc_log_epoch(uint32_t clock, uint32_t cycles){
+    uint32_t epoch = clock >> 21;
+    if(CDC_LOG_CLOCK_CYCLES(cycles) < (clock & CDC_LOG_CLOCK_MASK)){
+        epoch++;
+    }
+    return epoch & CDC_LOG_EPOCH_MASK;
+}
+
+static uint32_t cdc_log_clock(void){
+    uint32_t cycles = DWT->CYCCNT;
+    uint32_t epoch = cdc_log_epoch(cdcLog.clock, cycles);
+    __atomic_store_n(&cdcLog.clock, (epoch << 21) | CDC_LOG_CLOCK_CYCLES(cycles), __ATOMIC_RELAXED);
+    return cycles;
+}
+
+bool cdc_log_record(uint32_t header, const uint32_t *args){
+    uint32_t count = CDC_LOG_COUNT(header);
+    uint32_t size = 2 + count;
+    uint32_t clock = __atomic_load_n(&cdcLog.clock, __ATOMIC_RELAXED);
+    uint32_t timestamp = DWT->CYCCNT;
+    uint32_t head = __atomic_load_n(&cdcLog.head, __ATOMIC_RELAXED);
+    if(count > CDC_LOG_MAX_ARGS){
+        return false;
+    }
+    do {
+        uint32_t used = head - __atomic_load_n(&cdcLog.tail, __ATOMIC_ACQUIRE);
+        if(size > CDC_LOG_RING_WORDS - used){
+            __atomic_fetch_add(&cdcLog.dropped, 1, __ATOMIC_RELAXED);
+            return false;
+        }
+    } while(!__atomic_compare_exchange_n(&cdcLog.head, &head, head + size, true,
+                                         __ATOMIC_ACQUIRE, __ATOMIC_RELAXED));
+    cdcLog.words[(head + 1) & CDC_LOG_MASK] = timestamp;
+    for(uint32_t i = 0; i < count; i++){
+        cdcLog.words[(head + 2 + i) & CDC_LOG_MASK] = args[i];
+    }
+    header |= CDC_LOG_VALID | (cdc_log_epoch(clock, timestamp) << CDC_LOG_EPOCH_SHIFT);
+    __atomic_store_n(&cdcLog.words[head & CDC_LOG_MASK], header, __ATOMIC_RELEASE);
+    return true;
+}
+
+void cdc_log_task(void){
+    uint32_t cycles = cdc_log_clock();
+    if(!cdcLog.output || !cdc_frame_ready()){
+        return;     // The epoch is kept either way
+    }
+    uint32_t tail = cdcLog.tail;
+    uint16_t length = 0;
+    uint32_t dropped = __atomic_load_n(&cdcLog.dropped, __ATOMIC_RELAXED);
+    if(dropped != cdcLog.reported){
+        cdcLogFrame[length++] = CDC_LOG_HEADER(CDC_LOG_ID_DROPPED, 1) |
+                                ((cdcLog.clock >> 21) << CDC_LOG_EPOCH_SHIFT);
+        cdcLogFrame[length++] = cycles;
+        cdcLogFrame[length++] = dropped - cdcLog.reported;
+    }
+    for(;;){
+        uint32_t header = __atomic_load_n(&cdcLog.words[tail & CDC_LOG_MASK], __ATOMIC_ACQUIRE);
+        if((header & CDC_LOG_VALID) == 0){
+            break;
+        }
+        uint32_t size = 2 + CDC_LOG_COUNT(header);
+        if(length + size > CDC_LOG_FRAME_WORDS){
+            break;
+        }
+        for(uint32_t i = 0; i < size; i++){
+            cdcLogFrame[length++] = cdcLog.words[(tail + i) & CDC_LOG_MASK];
+        }
+        tail += size;
+    }
+    if(length == 0){
+        return;
+    }
+    if(!cdc_frame_send(CDC_LOG_CHANNEL, cdcLogFrame, length * sizeof(uint32_t))){
+        return;     // The records stay in the ring for the next call
+    }
+    cdcLog.reported = dropped;
+    for(uint32_t position = cdcLog.tail; position != tail; position++){
+        cdcLog.words[position & CDC_LOG_MASK] = 0;
+    }
+    __atomic_store_n(&cdcLog.tail, tail, __ATOMIC_RELEASE);
+}
+
+void cdc_log_set_output(bool enable){
+    cdcLog.output = enable;
+}
+
+uint32_t cdc_log_dropped(void){
+    return __atomic_load_n(&cdcLog.dropped, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,144 @@
+/**
+ * @file cdc_log.h
+ * @brief Deferred binary logger drained over the CDC console
+ *
+ * A log call does no formatting on the device. CDC_LOG() stores a compact
+ * record in a RAM ring:
+ *
+ *     header: bit 31 set, epoch in bits 20-30, argument count in bits 16-19,
+ *             format id in bits 0-15
+ *     timestamp: DWT cycle counter
+ *     arguments: one 32-bit word each
+ *
+ * The epoch counts the wraps of the cycle counter (every 2^32 cycles, about
+ * 36 s at 120 MHz), so the host gets absolute times over 2048 wraps.
+ *
+ * The format string itself is placed in the .cdc_log section, which the
+ * linker script keeps in the ELF file only (INFO section at address 0), so
+ * its address is the format id and the strings take no flash. The host tool
+ * tools/cdc_log_decode.py reads the strings back from the ELF file and
+ * formats the records.
+ *
+ * Space in the ring is reserved with an atomic compare-and-swap, so log
+ * calls may come from the main loop and from interrupt handlers. A record
+ * that does not fit is dropped and counted; the count is reported to the
+ * host as a record of its own (CDC_LOG_ID_DROPPED).
+ *
+ * cdc_log_task() drains the ring in the background as binary frames
+ * (cdc_frame.h) on CDC_LOG_CHANNEL, each carrying whole records. It also
+ * keeps the epoch, so it must run at least once per wrap of the counter.
+ * The frames are binary, so nothing is sent until cdc_log_set_output()
+ * enables it, typically with machine mode; an interactive terminal never
+ * sees them.
+ *
+ * @author Alejandro Beltran
+ * @date October 2026
+ */
+
+#ifndef _CDC_LOG_H
+#define _CDC_LOG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+extern "C" {
+#endif
+// DOM-IGNORE-END
+
+//! @brief Size of the record ring in 32-bit words (power of 2)
+#define CDC_LOG_RING_WORDS 1024
+//! @brief Most arguments of one log call
+#define CDC_LOG_MAX_ARGS 4
+//! @brief Frame channel of the log records
+#define CDC_LOG_CHANNEL 2
+//! @brief Format id of the record reporting dropped records
+#define CDC_LOG_ID_DROPPED 0xFFFF
+
+//! @brief Marks a committed record header
+#define CDC_LOG_VALID (1UL << 31)
+//! @brief Builds a record header, the epoch is added by cdc_log_record()
+#define CDC_LOG_HEADER(id, count) (CDC_LOG_VALID | ((uint32_t)(count) << 16) | (uint16_t)(id))
+
+/**
+ * @brief Logs a message with up to CDC_LOG_MAX_ARGS integer arguments
+ *
+ * The format is a printf() format literal using d, i, u, x, X, o and c
+ * conversions; each argument is stored as one 32-bit word. Floating point
+ * values should be logged scaled, e.g. in millivolts.
+ *
+ * @code
+ * CDC_LOG("adc %u: code %d out of range", channel, code);
+ * @endcode
+ */
+#define CDC_LOG(...) \
+    CDC_LOG_SELECT(__VA_ARGS__, CDC_LOG_4, CDC_LOG_3, CDC_LOG_2, CDC_LOG_1, CDC_LOG_0, unused)(__VA_ARGS__)
+
+// DOM-IGNORE-BEGIN
+#define CDC_LOG_SELECT(_0, _1, _2, _3, _4, name, ...) name
+#define CDC_LOG_0(format) CDC_LOG_RECORD(format, 0, 0)
+#define CDC_LOG_1(format, a) CDC_LOG_RECORD(format, 1, (uint32_t)(a))
+#define CDC_LOG_2(format, a, b) CDC_LOG_RECORD(format, 2, (uint32_t)(a), (uint32_t)(b))
+#define CDC_LOG_3(format, a, b, c) CDC_LOG_RECORD(format, 3, (uint32_t)(a), (uint32_t)(b), (uint32_t)(c))
+#define CDC_LOG_4(format, a, b, c, d) \
+    CDC_LOG_RECORD(format, 4, (uint32_t)(a), (uint32_t)(b), (uint32_t)(c), (uint32_t)(d))
+#define CDC_LOG_RECORD(format, count, ...) do { \
+        static const char cdc_log_format[] __attribute__((section(".cdc_log"), used)) = format; \
+        const uint32_t cdc_log_args[] = { __VA_ARGS__ }; \
+        cdc_log_record(CDC_LOG_HEADER((uintptr_t)cdc_log_format, count), cdc_log_args); \
+    } while(0)
+// DOM-IGNORE-END
+
+/**
+ * @brief Starts the timestamp counter
+ *
+ * Enables the DWT cycle counter used for the record timestamps.
+ */
+void cdc_log_initialize(void);
+
+/**
+ * @brief Stores one record, used by CDC_LOG()
+ *
+ * @param header CDC_LOG_HEADER() of the record
+ * @param args Argument words, as many as the count in the header
+ * @return false if the ring was full and the record was dropped
+ */
+bool cdc_log_record(uint32_t header, const uint32_t *args);
+
+/**
+ * @brief Sends the stored records to the host
+ *
+ * Call from the main loop, at least once per wrap of the cycle counter.
+ * While the output is enabled, sends one frame of whole records when a
+ * frame buffer is free; the records stay in the ring until the frame is
+ * queued.
+ */
+void cdc_log_task(void);
+
+/**
+ * @brief Enables or disables sending the records
+ *
+ * Disabled after cdc_log_initialize(). While disabled, records are kept in
+ * the ring; once it is full the new ones are dropped and counted, and the
+ * count is reported when the output is enabled again.
+ *
+ * @param enable true to send the records from cdc_log_task()
+ */
+void cdc_log_set_output(bool enable);
+
+/**
+ * @brief Gets the number of records dropped because the ring was full
+ *
+ * @return uint32_t Dropped records since start
+ */
+uint32_t cdc_log_dropped(void);
+
+//DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+}
+#endif
+//DOM-IGNORE-END
+
+#endif /* _CDC_LOG_H */
@@ -0,0 +1,191 @@
+/**
+ * @file cdc_telemetry.c
+ * @brief Implementation of the telemetry publish/subscribe scheduler
+ *
+ * Every subscribed source has a countdown reloaded with its period. A due
+ * value that differs from the last value sent is marked pending and goes
+ * into every packet until one of them has been queued, so a busy frame
+ * buffer delays values but never drops a change.
+ *
+ * @author Alejandro Beltran
+ * @date October 2026
+ */
+
+#include "cdc_telemetry.h"
+#include "cdc_command.h"
+#include "cdc_format.h"
+#include "cdc_frame.h"
+
+#include <string.h>
+
+#define CDC_TELEMETRY_TIME_SIZE 4
+#define CDC_TELEMETRY_RECORD_SIZE 5
+
+/**
+ * @brief Subscription state of one source
+ */
+typedef struct {
+    uint16_t period;        // 0 when not subscribed
+    uint16_t remaining;     // Ticks until the source is due
+    int32_t last;           // Last value sent
+    int32_t value;          // Value waiting to be sent
+    bool fresh;             // Send the next value even if unchanged
+    bool pending;           // value has not been sent yet
+} cdc_telemetry_item_t;
+
+static const cdc_telemetry_source_t *telemetry_sources[CDC_TELEMETRY_SOURCES_MAX];
+static cdc_telemetry_item_t telemetry_items[CDC_TELEMETRY_SOURCES_MAX];
+static uint8_t telemetry_count;
+static uint32_t telemetry_time;
+static uint8_t telemetry_packet[CDC_TELEMETRY_TIME_SIZE + CDC_TELEMETRY_SOURCES_MAX * CDC_TELEMETRY_RECORD_SIZE];
+
+static int16_t cdc_telemetry_find(const char *name){
+    for(uint8_t i = 0; i < telemetry_count; i++){
+        if(strcmp(telemetry_sources[i]->name, name) == 0){
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void cdc_telemetry_put32(uint8_t *data, uint32_t value){
+    data[0] = (uint8_t)value;
+    data[1] = (uint8_t)(value >> 8);
+    data[2] = (uint8_t)(value >> 16);
+    data[3] = (uint8_t)(value >> 24);
+}
+
+bool cdc_telemetry_register(const cdc_telemetry_source_t *sources, uint8_t count){
+    if(sources == NULL){
+        return false;
+    }
+    for(uint8_t i = 0; i < count; i++){
+        if(sources[i].name == NULL || sources[i].read == NULL ||
+           telemetry_count == CDC_TELEMETRY_SOURCES_MAX){
+            return false;
+        }
+        telemetry_sources[telemetry_count++] = &sources[i];
+    }
+    return true;
+}
+
+int16_t cdc_telemetry_subscribe(const char *name, uint16_t period_ms){
+    int16_t id = (name != NULL) ? cdc_telemetry_find(name) : -1;
+    if(id < 0 || period_ms == 0){
+        return -1;
+    }
+    cdc_telemetry_item_t *item = &telemetry_items[id];
+    item->period = period_ms;
+    item->remaining = 1;
+    item->fresh = true;
+    item->pending = false;
+    return id;
+}
+
+bool cdc_telemetry_unsubscribe(const char *name){
+    int16_t id = (name != NULL) ? cdc_telemetry_find(name) : -1;
+    if(id < 0){
+        return false;
+    }
+    telemetry_items[id].period = 0;
+    telemetry_items[id].pending = false;
+    return true;
+}
+
+void cdc_telemetry_unsubscribe_all(void){
+    for(uint8_t i = 0; i < telemetry_count; i++){
+        telemetry_items[i].period = 0;
+        telemetry_items[i].pending = false;
+    }
+}
+
+void cdc_telemetry_tick(void){
+    uint16_t length = CDC_TELEMETRY_TIME_SIZE;
+    telemetry_time++;
+    for(uint8_t i = 0; i < telemetry_count; i++){
+        cdc_telemetry_item_t *item = &telemetry_items[i];
+        if(item->period == 0){
+            continue;
+        }
+        if(--item->remaining == 0){
+            item->remaining = item->period;
+            int32_t value = telemetry_sources[i]->read();
+            if(item->fresh || item->pending || value != item->last){
+                item->value = value;
+                item->pending = true;
+            }
+        }
+        if(item->pending){
+            telemetry_packet[length] = i;
+            cdc_telemetry_put32(&telemetry_packet[length + 1], (uint32_t)item->value);
+            length += CDC_TELEMETRY_RECORD_SIZE;
+        }
+    }
+    if(length == CDC_TELEMETRY_TIME_SIZE){
+        return;     // Nothing due or nothing changed
+    }
+    cdc_telemetry_put32(telemetry_packet, telemetry_time);
+    if(!cdc_frame_send(CDC_TELEMETRY_CHANNEL, telemetry_packet, length)){
+        return;
+    }
+    for(uint8_t i = 0; i < telemetry_count; i++){
+        cdc_telemetry_item_t *item = &telemetry_items[i];
+        if(item->pending){
+            item->last = item->value;
+            item->pending = false;
+            item->fresh = false;
+        }
+    }
+}
+
+static bool cdc_telemetry_sources_command(const cdc_command_args_t *args){
+    char text[CDC_COMMAND_NAME_MAX + 8];
+    cdc_format_line_t line;
+    if(args->argc != 1){
+        return false;
+    }
+    for(uint8_t i = 0; i < telemetry_count; i++){
+        cdc_format_line_init(&line, text, sizeof(text));
+        cdc_format_line_uint(&line, i);
+        cdc_format_line_char(&line, ' ');
+        cdc_format_line_str(&line, telemetry_sources[i]->name);
+        cdc_command_respond(cdc_format_line_text(&line));
+    }
+    return true;
+}
+
+static bool cdc_telemetry_sub_command(const cdc_command_args_t *args){
+    int32_t period;
+    char text[CDC_FORMAT_NUMBER_MAX + 1];
+    if(args->argc != 3 || !cdc_command_arg_int(args, 2, 1, UINT16_MAX, &period)){
+        return false;
+    }
+    int16_t id = cdc_telemetry_subscribe(args->argv[1], (uint16_t)period);
+    if(id < 0){
+        return false;
+    }
+    text[cdc_format_int(text, sizeof(text) - 1, id)] = '\0';
+    cdc_command_respond(text);
+    return true;
+}
+
+static bool cdc_telemetry_unsub_command(const cdc_command_args_t *args){
+    if(args->argc != 2){
+        return false;
+    }
+    if(strcmp(args->argv[1], "all") == 0){
+        cdc_telemetry_unsubscribe_all();
+        return true;
+    }
+    return cdc_telemetry_unsubscribe(args->argv[1]);
+}
+
+static const cdc_command_t telemetry_commands[] = {
+    CDC_COMMAND("sources", cdc_telemetry_sources_command, "sources"),
+    CDC_COMMAND("sub", cdc_telemetry_sub_command, "sub <source> <period_ms>"),
+    CDC_COMMAND("unsub", cdc_telemetry_unsub_command, "unsub <source>|all"),
+};
+
+bool cdc_telemetry_initialize(void){
+    return cdc_command_register(telemetry_commands, sizeof(telemetry_commands) / sizeof(telemetry_commands[0]));
+}
@@ -0,0 +1,123 @@
+/**
+ * @file cdc_telemetry.h
+ * @brief Periodic telemetry publishing over the CDC console
+ *
+ * The application registers named data sources (ADC channels, DAC
+ * setpoints, counters...), each read by a function returning a 32-bit
+ * value. The host subscribes to the sources it wants, each at its own
+ * period, with console commands, and the device then pushes the values
+ * without being polled.
+ *
+ * cdc_telemetry_tick() is called once per millisecond. It reads every
+ * subscribed source whose period has elapsed, skips the values that have
+ * not changed since they were last sent, and sends the others together in
+ * one binary frame (cdc_frame.h) on CDC_TELEMETRY_CHANNEL:
+ *
+ *     time (uint32, ms) { id (uint8) value (int32) }...
+ *
+ * all little-endian. The id of a source is its registration index, returned
+ * by the sub command and listed by the sources command.
+ *
+ * Console commands, registered by cdc_telemetry_initialize():
+ *
+ * - sources: Lists the id and name of every source
+ * - sub <name> <period_ms>: Publishes a source every period_ms milliseconds
+ * - unsub <name>|all: Stops publishing a source or all of them
+ *
+ * @author Alejandro Beltran
+ * @date October 2026
+ */
+
+#ifndef _CDC_TELEMETRY_H
+#define _CDC_TELEMETRY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+extern "C" {
+#endif
+// DOM-IGNORE-END
+
+//! @brief Most sources that can be registered
+#define CDC_TELEMETRY_SOURCES_MAX 32
+//! @brief Frame channel of the telemetry packets
+#define CDC_TELEMETRY_CHANNEL 1
+
+/**
+ * @brief Telemetry data source
+ */
+typedef struct
+{
+    /** @brief Name used by the sub and unsub commands */
+    const char * name;
+    /** @brief Returns the current value; called from cdc_telemetry_tick() */
+    int32_t (*read)(void);
+} cdc_telemetry_source_t;
+
+/**
+ * @brief Registers the telemetry console commands
+ *
+ * @return true if the commands were registered
+ */
+bool cdc_telemetry_initialize(void);
+
+/**
+ * @brief Registers a table of sources
+ *
+ * The table is not copied and must stay valid. Sources get consecutive ids
+ * in registration order.
+ *
+ * @param sources Sources to register
+ * @param count Number of sources
+ * @return true if all the sources were registered
+ * @return false if a source has no name or read function, or
+ *               CDC_TELEMETRY_SOURCES_MAX would be exceeded; the sources
+ *               before the failing one stay registered
+ */
+bool cdc_telemetry_register(const cdc_telemetry_source_t *sources, uint8_t count);
+
+/**
+ * @brief Publishes a source periodically
+ *
+ * Subscribing again changes the period. The value is sent on the next tick,
+ * changed or not.
+ *
+ * @param name Name of the source
+ * @param period_ms Publishing period in milliseconds (at least 1)
+ * @return int16_t Id of the source, -1 if there is no such source or the
+ *         period is 0
+ */
+int16_t cdc_telemetry_subscribe(const char *name, uint16_t period_ms);
+
+/**
+ * @brief Stops publishing a source
+ *
+ * @param name Name of the source
+ * @return false if there is no such source
+ */
+bool cdc_telemetry_unsubscribe(const char *name);
+
+/**
+ * @brief Stops publishing all the sources
+ */
+void cdc_telemetry_unsubscribe_all(void);
+
+/**
+ * @brief Advances the scheduler by one millisecond
+ *
+ * Reads the due sources and sends the changed values in one frame. When
+ * the frame cannot be queued (e.g. the frame buffers are busy) the values
+ * are sent on the next tick instead.
+ */
+void cdc_telemetry_tick(void);
+
+//DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+}
+#endif
+//DOM-IGNORE-END
+
+#endif /* _CDC_TELEMETRY_H */
@@ -14,15 +14,132 @@
 #include "cdc_usb_platform.h"
 #include <sys/types.h>
 
-uint8_t CACHE_ALIGN cdcReadBuffer[APP_READ_BUFFER_SIZE];
-uint8_t CACHE_ALIGN cdcWriteBuffer[APP_READ_BUFFER_SIZE];
+uint8_t CACHE_ALIGN cdcReadBuffer[CDC_USB_RX_IRPS][APP_READ_BUFFER_SIZE];
+uint8_t CACHE_ALIGN cdcWriteBuffer[CDC_USB_TX_IRPS][CDC_USB_TX_IRP_SIZE];
 
 char commandBuffer[APP_READ_BUFFER_SIZE];
 
-static uint8_t command_index;
+static uint16_t command_index;
+static bool command_overflow;
+static uint16_t line_received;
+static uint16_t line_delivered = 0xFFFF;
+static bool command_echo = true;
 static void (*return_line_callback)(char*) = NULL;
 static void (*console_ready_callback)(void) = NULL;
 
+/**
+ * @brief Read transfer slots
+ *
+ * All CDC_USB_RX_IRPS reads are kept posted, so the host can keep sending
+ * while a received buffer is parsed. Reads complete in the order they were
+ * posted: READ_COMPLETE fills `slotDone`, the parser consumes `slotParse` and
+ * posts the slot again. A parse stopped by a full line queue leaves `offset`
+ * bytes of `slotParse` consumed and the slot held. `parsing` keeps the USB
+ * interrupt and the main loop from running the parser at the same time, as
+ * `draining` does for the transmit side, and `generation` changes when the
+ * port is opened again so that a parse running across it gives up.
+ *
+ * Harmony fails every posted read when it cancels them on a bus reset or a
+ * deconfiguration, before the device is marked unconfigured. A failed read
+ * sets `halted`: its slot is dropped and no read is posted again until the
+ * CONFIGURED event re-arms all the slots, since a read posted from the
+ * completion would go into the queue being cancelled.
+ */
+static struct {
+    USB_DEVICE_CDC_TRANSFER_HANDLE handles[CDC_USB_RX_IRPS];
+    uint16_t length[CDC_USB_RX_IRPS];
+    uint16_t offset;
+    uint8_t slotDone;
+    uint8_t slotParse;
+    volatile uint8_t slotsFilled;
+    volatile uint8_t generation;
+    volatile bool parsing;
+    volatile bool kick;
+    volatile bool halted;
+} cdcRx;
+
+/**
+ * @brief Received lines waiting for cdc_usb_line_task()
+ *
+ * Single producer (the parser) and single consumer (the main loop) over
+ * free-running counters. Each line keeps its number and the cdcRx
+ * generation it was received in.
+ */
+static struct {
+    char text[CDC_USB_LINE_QUEUE][APP_READ_BUFFER_SIZE];
+    uint16_t number[CDC_USB_LINE_QUEUE];
+    uint8_t generation[CDC_USB_LINE_QUEUE];
+    volatile uint8_t head;
+    volatile uint8_t tail;
+} cdcLines;
+
+#define CDC_USB_LINE_MASK (CDC_USB_LINE_QUEUE - 1U)
+
+/**
+ * @brief Transmit ring and write transfer slots
+ *
+ * The ring holds a stream of records, each starting with a 16-bit header.
+ * A copy record carries `header` bytes of data; a reference record
+ * (CDC_USB_TX_REFERENCE set) carries a completion callback, its
+ * context and `header & CDC_USB_TX_LENGTH` segment descriptors pointing at
+ * caller-owned buffers. Keeping both kinds in one stream preserves the order
+ * of all writes.
+ *
+ * Producers reserve space with a compare-and-swap on `reserve`, which packs
+ * the free-running head index (low 16 bits) and the number of producers
+ * still copying (high 16 bits). The ring content up to the head is complete
+ * only when no producer is copying; the last producer to finish drains it.
+ * In coalescing mode it only does so when a transfer's worth of data is
+ * queued or a flush was requested, and the SOF event drains the rest once
+ * per 1 ms frame.
+ *
+ * The drain turns records into write transfers: consecutive copy records are
+ * packed into the cdcWriteBuffer slots, each segment of a reference record is
+ * submitted as its own transfer straight from the caller's buffer. It is the
+ * only writer of `tail`, `offset` and `slotNext`; `draining` keeps the main
+ * loop and the USB interrupt from running it at the same time. Transfers
+ * complete in order, so the WRITE_COMPLETE event only has to advance
+ * `slotDone` and decrement `slotsBusy`.
+ *
+ * A reset marks the records queued up to `discardHead` as dropped. The drain
+ * walks them, calling the callbacks of reference records, once no producer
+ * is copying, since a record being copied has no valid header yet.
+ *
+ * A failed write, which is how Harmony reports the transfers it cancels on a
+ * bus reset or a deconfiguration, sets `halted`: its slot is released but
+ * nothing is submitted until the CONFIGURED event resets the ring.
+ */
+static struct {
+    uint8_t ring[CDC_USB_TX_RING_SIZE];
+    volatile uint32_t reserve;
+    volatile uint16_t tail;
+    uint16_t offset;                    // Bytes or segments of the tail record already submitted
+    uint8_t slotNext;
+    uint8_t slotDone;
+    volatile uint8_t slotsBusy;
+    volatile bool draining;
+    volatile bool kick;
+    volatile bool coalesce;
+    volatile bool flush;
+    volatile bool discard;
+    volatile bool halted;
+    uint16_t discardHead;
+    USB_DEVICE_CDC_TRANSFER_HANDLE handles[CDC_USB_TX_IRPS];
+    cdc_usb_write_done_t done[CDC_USB_TX_IRPS];
+    void *context[CDC_USB_TX_IRPS];
+} cdcTx;
+
+#define CDC_USB_TX_WRITERS_ONE  (1UL << 16)
+#define CDC_USB_TX_HEAD(r)      ((uint16_t)((r) & 0xFFFF))
+#define CDC_USB_TX_WRITERS(r)   ((r) >> 16)
+
+#define CDC_USB_TX_REFERENCE         0x8000U
+#define CDC_USB_TX_LENGTH       0x7FFFU
+#define CDC_USB_TX_HEADER_SIZE  2U
+#define CDC_USB_TX_REF_SIZE(n)  (CDC_USB_TX_HEADER_SIZE + sizeof(cdc_usb_write_done_t) + \
+                                 sizeof(void *) + (n) * sizeof(cdc_usb_segment_t))
+#define CDC_USB_BULK_PACKET     64U
+
 cdc_usb_t usbState = {
     /* Device Layer Handle  */
     .deviceHandle = USB_DEVICE_HANDLE_INVALID ,
@@ -41,35 +158,345 @@ cdc_usb_t usbState = {
     .isReadComplete = false,
     /*Initialize the write complete flag*/
     .isWriteComplete = true,
-    /* Set up the read buffer */
-    .cdcReadBuffer = &cdcReadBuffer[0],
-    /* Set up the read buffer */
-    .cdcWriteBuffer = &cdcWriteBuffer[0],
+    /* Set up the read buffer (first read transfer slot) */
+    .cdcReadBuffer = &cdcReadBuffer[0][0],
+    /* Set up the write buffer (first write transfer slot) */
+    .cdcWriteBuffer = &cdcWriteBuffer[0][0],
     /* Number of bytes read from Host */ 
     .numBytesRead = 0,
+    /* Writes rejected because the transmit ring was full */
+    .txOverflows = 0,
+    /* Lines discarded because they did not fit in the command buffer */
+    .rxOverflows = 0,
+    /* Transmit statistics */
+    .txTransfers = 0,
+    .txPackets = 0,
+    .txBytes = 0,
 };
 
+/**
+ * @brief Copy bytes into the ring, wrapping at its end
+ */
+static void cdc_usb_tx_put(uint16_t position, const void *data, size_t length)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+    for(size_t i = 0; i < length; i++){
+        cdcTx.ring[(uint16_t)(position + i) & (CDC_USB_TX_RING_SIZE - 1)] = bytes[i];
+    }
+}
+
+/**
+ * @brief Copy bytes out of the ring, wrapping at its end
+ */
+static void cdc_usb_tx_get(uint16_t position, void *data, size_t length)
+{
+    uint8_t *bytes = (uint8_t *)data;
+    for(size_t i = 0; i < length; i++){
+        bytes[i] = cdcTx.ring[(uint16_t)(position + i) & (CDC_USB_TX_RING_SIZE - 1)];
+    }
+}
+
+static uint16_t cdc_usb_tx_header(uint16_t position)
+{
+    uint8_t header[CDC_USB_TX_HEADER_SIZE];
+    cdc_usb_tx_get(position, header, sizeof(header));
+    return (uint16_t)(header[0] | (header[1] << 8));
+}
+
+/**
+ * @brief Reserve a record in the ring and register as a producer
+ *
+ * @param size Size of the record including its header
+ * @param position Receives the ring index of the record
+ * @return false if the ring has no room, the write is counted in txOverflows
+ */
+static bool cdc_usb_tx_reserve(size_t size, uint16_t *position)
+{
+    uint32_t reserve = __atomic_load_n(&cdcTx.reserve, __ATOMIC_RELAXED);
+    uint32_t next;
+    do {
+        uint16_t used = CDC_USB_TX_HEAD(reserve) - cdcTx.tail;
+        if(size > (size_t)(CDC_USB_TX_RING_SIZE - used)){
+            usbState.txOverflows++;
+            return false;
+        }
+        next = ((CDC_USB_TX_WRITERS(reserve) + 1) << 16) | (uint16_t)(CDC_USB_TX_HEAD(reserve) + size);
+    } while(!__atomic_compare_exchange_n(&cdcTx.reserve, &reserve, next, true,
+                                         __ATOMIC_ACQ_REL, __ATOMIC_RELAXED));
+    *position = CDC_USB_TX_HEAD(reserve);
+    return true;
+}
+
+static void cdc_usb_tx_drain(void);
+
+/**
+ * @brief Drain the ring unless the data is being coalesced
+ *
+ * When coalescing, the drain is left to the next SOF unless a flush or a
+ * discard was requested or a full transfer is waiting.
+ */
+static void cdc_usb_tx_poke(uint32_t reserve)
+{
+    if(CDC_USB_TX_WRITERS(reserve) == 0 &&
+       (!cdcTx.coalesce || cdcTx.flush || cdcTx.discard ||
+        (uint16_t)(CDC_USB_TX_HEAD(reserve) - cdcTx.tail) >= CDC_USB_TX_IRP_SIZE)){
+        cdc_usb_tx_drain();
+    }
+}
+
+/**
+ * @brief Unregister as a producer; the last one to finish drains the ring
+ */
+static void cdc_usb_tx_commit(bool flush)
+{
+    if(flush){
+        cdcTx.flush = true;
+    }
+    cdc_usb_tx_poke(__atomic_sub_fetch(&cdcTx.reserve, CDC_USB_TX_WRITERS_ONE, __ATOMIC_ACQ_REL));
+}
+
+/**
+ * @brief Start a write transfer in the next slot
+ *
+ * A transfer that is a multiple of the packet size and is followed by more
+ * data is sent without a zero-length packet.
+ *
+ * @return false if the USB stack refused the transfer; its callback has then
+ *         been called already
+ */
+static bool cdc_usb_tx_submit(const void *data, size_t length, bool more,
+                              cdc_usb_write_done_t done, void *context)
+{
+    uint8_t slot = cdcTx.slotNext;
+    USB_DEVICE_CDC_TRANSFER_FLAGS flags = USB_DEVICE_CDC_TRANSFER_FLAGS_DATA_COMPLETE;
+    uint32_t packets = length / CDC_USB_BULK_PACKET + 1;   // Short packet or ZLP
+    if(more && (length % CDC_USB_BULK_PACKET) == 0){
+        flags = USB_DEVICE_CDC_TRANSFER_FLAGS_MORE_DATA_PENDING;
+        packets--;
+    }
+    cdcTx.done[slot] = done;
+    cdcTx.context[slot] = context;
+    cdcTx.handles[slot] = USB_DEVICE_CDC_TRANSFER_HANDLE_INVALID;
+    __atomic_add_fetch(&cdcTx.slotsBusy, 1, __ATOMIC_ACQ_REL);
+    usbState.isWriteComplete = false;
+    if(USB_DEVICE_CDC_Write(USB_DEVICE_CDC_INDEX_0, &cdcTx.handles[slot],
+            data, length, flags) != USB_DEVICE_CDC_RESULT_OK){
+        // The data of this slot is lost
+        usbState.isWriteComplete = (__atomic_sub_fetch(&cdcTx.slotsBusy, 1, __ATOMIC_ACQ_REL) == 0);
+        if(done != NULL){
+            done(context);
+        }
+        return false;
+    }
+    usbState.writeTransferHandle = cdcTx.handles[slot];
+    cdcTx.slotNext = (slot + 1 == CDC_USB_TX_IRPS) ? 0 : slot + 1;
+    usbState.txTransfers++;
+    usbState.txPackets += packets;
+    usbState.txBytes += length;
+    return true;
+}
+
+/**
+ * @brief Pack consecutive copy records into the next write transfer slot
+ */
+static bool cdc_usb_tx_drain_copy(uint16_t head)
+{
+    uint8_t *buffer = cdcWriteBuffer[cdcTx.slotNext];
+    uint16_t tail = cdcTx.tail;
+    uint16_t length = 0;
+
+    while(length < CDC_USB_TX_IRP_SIZE && tail != head){
+        uint16_t header = cdc_usb_tx_header(tail);
+        if(header & CDC_USB_TX_REFERENCE){
+            break;
+        }
+        uint16_t count = header - cdcTx.offset;
+        if(count > CDC_USB_TX_IRP_SIZE - length){
+            count = CDC_USB_TX_IRP_SIZE - length;
+        }
+        cdc_usb_tx_get(tail + CDC_USB_TX_HEADER_SIZE + cdcTx.offset, &buffer[length], count);
+        length += count;
+        cdcTx.offset += count;
+        if(cdcTx.offset == header){
+            tail += CDC_USB_TX_HEADER_SIZE + header;
+            cdcTx.offset = 0;
+        }
+    }
+    __atomic_store_n(&cdcTx.tail, tail, __ATOMIC_RELEASE);
+    return cdc_usb_tx_submit(buffer, length, tail != head || cdcTx.offset != 0, NULL, NULL);
+}
+
+/**
+ * @brief Submit the next segment of the reference record at the tail
+ */
+static bool cdc_usb_tx_drain_reference(uint16_t head)
+{
+    uint16_t tail = cdcTx.tail;
+    uint16_t count = cdc_usb_tx_header(tail) & CDC_USB_TX_LENGTH;
+    cdc_usb_write_done_t done = NULL;
+    void *context = NULL;
+    cdc_usb_segment_t segment;
+
+    cdc_usb_tx_get(tail + CDC_USB_TX_REF_SIZE(cdcTx.offset), &segment, sizeof(segment));
+    if(++cdcTx.offset == count){
+        // The callback goes with the last segment
+        cdc_usb_tx_get(tail + CDC_USB_TX_HEADER_SIZE, &done, sizeof(done));
+        cdc_usb_tx_get(tail + CDC_USB_TX_HEADER_SIZE + sizeof(done), &context, sizeof(context));
+        cdcTx.offset = 0;
+        tail += CDC_USB_TX_REF_SIZE(count);
+        __atomic_store_n(&cdcTx.tail, tail, __ATOMIC_RELEASE);
+    }
+    if(segment.length == 0){
+        if(done != NULL){
+            done(context);
+        }
+        return true;
+    }
+    return cdc_usb_tx_submit(segment.data, segment.length, tail != head || cdcTx.offset != 0, done, context);
+}
+
+/**
+ * @brief Drop the records up to discardHead, releasing reference buffers
+ *
+ * Called by the drain when no producer is copying.
+ */
+static void cdc_usb_tx_discard(void)
+{
+    uint16_t tail = cdcTx.tail;
+    while(tail != cdcTx.discardHead){
+        uint16_t header = cdc_usb_tx_header(tail);
+        if(header & CDC_USB_TX_REFERENCE){
+            cdc_usb_write_done_t done;
+            void *context;
+            cdc_usb_tx_get(tail + CDC_USB_TX_HEADER_SIZE, &done, sizeof(done));
+            cdc_usb_tx_get(tail + CDC_USB_TX_HEADER_SIZE + sizeof(done), &context, sizeof(context));
+            if(done != NULL){
+                done(context);
+            }
+            tail += CDC_USB_TX_REF_SIZE(header & CDC_USB_TX_LENGTH);
+        } else {
+            tail += CDC_USB_TX_HEADER_SIZE + header;
+        }
+    }
+    cdcTx.offset = 0;
+    cdcTx.discard = false;
+    __atomic_store_n(&cdcTx.tail, tail, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Move committed ring records into free write transfer slots
+ *
+ * Safe to call from the main loop and from the USB interrupt. A call that
+ * finds the drain already running leaves a kick for the running instance.
+ */
+static void cdc_usb_tx_drain(void)
+{
+    for(;;){
+        if(__atomic_exchange_n(&cdcTx.draining, true, __ATOMIC_ACQUIRE)){
+            cdcTx.kick = true;
+            return;
+        }
+        cdcTx.kick = false;
+        cdcTx.flush = false;
+
+        uint32_t reserve = __atomic_load_n(&cdcTx.reserve, __ATOMIC_ACQUIRE);
+        uint16_t head = CDC_USB_TX_HEAD(reserve);
+        if(CDC_USB_TX_WRITERS(reserve) != 0){
+            head = cdcTx.tail; // A producer is copying; it drains when it finishes
+        } else if(cdcTx.discard){
+            cdc_usb_tx_discard();
+        }
+        while(usbState.isConfigured && !cdcTx.halted && head != cdcTx.tail &&
+              cdcTx.slotsBusy < CDC_USB_TX_IRPS){
+            bool submitted;
+            if(cdc_usb_tx_header(cdcTx.tail) & CDC_USB_TX_REFERENCE){
+                submitted = cdc_usb_tx_drain_reference(head);
+            } else {
+                submitted = cdc_usb_tx_drain_copy(head);
+            }
+            if(!submitted){
+                break;
+            }
+        }
+
+        __atomic_store_n(&cdcTx.draining, false, __ATOMIC_RELEASE);
+        if(!cdcTx.kick){
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Drop all queued and in-flight transmit data
+ *
+ * The callbacks of dropped reference writes are called, so their buffers
+ * are released. In-flight transfers are dropped here; the queued records
+ * are dropped by the drain as soon as no producer is copying, which may be
+ * after this returns if the reset interrupted a write.
+ */
+static void cdc_usb_tx_reset(void)
+{
+    while(cdcTx.slotsBusy != 0){
+        uint8_t slot = cdcTx.slotDone;
+        cdcTx.slotDone = (slot + 1 == CDC_USB_TX_IRPS) ? 0 : slot + 1;
+        cdcTx.slotsBusy--;
+        if(cdcTx.done[slot] != NULL){
+            cdcTx.done[slot](cdcTx.context[slot]);
+        }
+    }
+    cdcTx.slotNext = cdcTx.slotDone;
+    cdcTx.halted = false;
+    usbState.isWriteComplete = true;
+    // Writes queued from now on belong to the new connection
+    cdcTx.discardHead = CDC_USB_TX_HEAD(__atomic_load_n(&cdcTx.reserve, __ATOMIC_ACQUIRE));
+    cdcTx.discard = true;
+    cdc_usb_tx_drain();
+}
+
+/**
+ * @brief Post the read transfer of a slot
+ *
+ * Nothing is posted while the device is not configured or reception is
+ * halted; the CONFIGURED event posts every slot again.
+ */
+static bool cdc_usb_rx_post(uint8_t slot)
+{
+    cdcRx.length[slot] = 0;
+    cdcRx.handles[slot] = USB_DEVICE_CDC_TRANSFER_HANDLE_INVALID;
+    if(!usbState.isConfigured || cdcRx.halted){
+        return false;
+    }
+    USB_DEVICE_CDC_RESULT result;
+    result = USB_DEVICE_CDC_Read (USB_DEVICE_CDC_INDEX_0,
+            &cdcRx.handles[slot], cdcReadBuffer[slot],
+            APP_READ_BUFFER_SIZE);
+    usbState.readTransferHandle = cdcRx.handles[slot];
+    return (result == USB_DEVICE_CDC_RESULT_OK);
+}
+
 bool cdc_usb_initialize ( void )
 {
     command_index = 0;                  // Initialize command index
+    command_overflow = false;
+    line_received = 0;                  // Lines are numbered per connection
+    line_delivered = 0xFFFF;
     usbState.cdcReadBuffer[0] = '\0';   // Initialize the receive buffer
     usbState.cdcWriteBuffer[0] = '\0';  // Initialize the write buffer
     commandBuffer[0] = '\0';            // Initialize the command buffer
+    cdc_usb_tx_reset();                 // Transfers of a previous connection are gone
+    cdcRx.generation++;                 // Lines and a parse of the previous connection are dropped
+    cdcRx.slotDone = 0;
+    cdcRx.slotParse = 0;
+    cdcRx.slotsFilled = 0;
+    cdcRx.offset = 0;
+    cdcRx.halted = false;
     if(usbState.isConfigured == true){
-        usbState.readTransferHandle =  USB_DEVICE_CDC_TRANSFER_HANDLE_INVALID;
-        USB_DEVICE_CDC_RESULT result;
-        result = USB_DEVICE_CDC_Read (USB_DEVICE_CDC_INDEX_0,
-                &usbState.readTransferHandle, usbState.cdcReadBuffer,
-                APP_READ_BUFFER_SIZE);
         usbState.isReadComplete = false;
-        if (result != USB_DEVICE_CDC_RESULT_OK)
-        {
-            return false;
-        }
-        else
-        {
-            return true;
+        bool result = true;
+        for(uint8_t slot = 0; slot < CDC_USB_RX_IRPS; slot++){
+            result &= cdc_usb_rx_post(slot);
         }
+        return result;
     }
     return false;
 }
@@ -89,8 +516,12 @@ void APP_USBDeviceEventHandler
     switch(event)
     {
         case USB_DEVICE_EVENT_SOF:
+            /* Start of a 1 ms frame: send what was coalesced since the
+             * previous one */
+            cdc_usb_tx_drain();
             break;
         case USB_DEVICE_EVENT_RESET:
+        case USB_DEVICE_EVENT_DECONFIGURED:
             usbState.isConfigured = false;
             break;
         case USB_DEVICE_EVENT_CONFIGURED:
@@ -142,6 +573,7 @@ USB_DEVICE_CDC_EVENT_RESPONSE APP_USBDeviceCDCEventHandler
     cdc_usb_t * usbStateObject;
     USB_CDC_CONTROL_LINE_STATE * controlLineStateData;
     USB_DEVICE_CDC_EVENT_DATA_READ_COMPLETE * eventDataRead;
+    USB_DEVICE_CDC_EVENT_DATA_WRITE_COMPLETE * eventDataWrite;
 
     usbStateObject = (cdc_usb_t *)userData;
 
@@ -180,12 +612,23 @@ USB_DEVICE_CDC_EVENT_RESPONSE APP_USBDeviceCDCEventHandler
             USB_DEVICE_ControlStatus(usbStateObject->deviceHandle, USB_DEVICE_CONTROL_STATUS_OK);
             break;
         case USB_DEVICE_CDC_EVENT_READ_COMPLETE:
-            /* This means that the host has sent some data*/
+            /* This means that the host has sent some data. Reads complete
+             * in order, so this is the oldest posted slot. A failed read was
+             * cancelled by a reset or a deconfiguration: its slot is dropped
+             * and the reads stay unposted until the device is configured. */
             eventDataRead = (USB_DEVICE_CDC_EVENT_DATA_READ_COMPLETE *)pData;
-            if(eventDataRead->status != USB_DEVICE_CDC_RESULT_ERROR)
+            if(eventDataRead->status != USB_DEVICE_CDC_RESULT_OK)
             {
-                usbStateObject->isReadComplete = true;
+                cdcRx.halted = true;
+            }
+            else if(!cdcRx.halted && cdcRx.slotsFilled < CDC_USB_RX_IRPS)
+            {
+                uint8_t slot = cdcRx.slotDone;
+                cdcRx.slotDone = (slot + 1 == CDC_USB_RX_IRPS) ? 0 : slot + 1;
+                cdcRx.length[slot] = eventDataRead->length;
                 usbStateObject->numBytesRead = eventDataRead->length;
+                __atomic_add_fetch(&cdcRx.slotsFilled, 1, __ATOMIC_RELEASE);
+                usbStateObject->isReadComplete = true;
                 cdc_usb_read_line();
             }
             break;
@@ -199,9 +642,28 @@ USB_DEVICE_CDC_EVENT_RESPONSE APP_USBDeviceCDCEventHandler
              * do much with this data in this demo. */
             break;
         case USB_DEVICE_CDC_EVENT_WRITE_COMPLETE:
-            /* This means that the data write got completed. We can schedule
-             * the next read. */
-            usbStateObject->isWriteComplete = true;
+            /* This means that the oldest write transfer got completed. Free
+             * its slot, release the caller's buffer of a reference write and
+             * chain the next transfer from the ring. A failed write was
+             * cancelled by a reset or a deconfiguration: nothing more is
+             * submitted until the device is configured. */
+            eventDataWrite = (USB_DEVICE_CDC_EVENT_DATA_WRITE_COMPLETE *)pData;
+            if(eventDataWrite->status != USB_DEVICE_CDC_RESULT_OK){
+                cdcTx.halted = true;
+            }
+            if(cdcTx.slotsBusy != 0){
+                uint8_t slot = cdcTx.slotDone;
+                cdc_usb_write_done_t done = cdcTx.done[slot];
+                void *context = cdcTx.context[slot];
+                cdcTx.slotDone = (slot + 1 == CDC_USB_TX_IRPS) ? 0 : slot + 1;
+                usbStateObject->isWriteComplete = (__atomic_sub_fetch(&cdcTx.slotsBusy, 1, __ATOMIC_ACQ_REL) == 0);
+                if(done != NULL){
+                    done(context);
+                }
+            }
+            if(usbStateObject->isConfigured && !cdcTx.halted){
+                cdc_usb_tx_poke(__atomic_load_n(&cdcTx.reserve, __ATOMIC_ACQUIRE));
+            }
             break;
         default:
             break;
@@ -213,42 +675,166 @@ cdc_usb_t* get_cdc_usb_handle(void){
     return &usbState;
 }
 
-void cdc_usb_read_line(void){
-    if(usbState.numBytesRead == 0 || usbState.isReadComplete == false){
-        return; // No data to process
+/**
+ * @brief Find the first control character of a received run
+ *
+ * Bytes below 0x20 and 0x7F are control characters. Aligned 32-bit words
+ * are tested four bytes at a time: (w - 0x20202020) & ~w & 0x80808080 is
+ * nonzero when some byte is below 0x20, and the same test on w ^ 0x7F7F7F7F
+ * catches DEL. Only a word that hits is looked at byte by byte.
+ *
+ * @return Index of the first control character, or length if there is none
+ */
+static uint16_t cdc_usb_scan(const uint8_t *data, uint16_t length){
+    uint16_t i = 0;
+    while(i < length && ((uintptr_t)&data[i] & 3) != 0){
+        if(data[i] < 0x20 || data[i] == 0x7F){
+            return i;
+        }
+        i++;
     }
-    char receivedBuffer[APP_READ_BUFFER_SIZE] = {0};
-    // Process the received data
-    for(uint16_t i = 0; i < usbState.numBytesRead; i++)
-    {
+    while(length - i >= 4){
+        uint32_t word;
+        memcpy(&word, &data[i], sizeof(word));
+        uint32_t del = word ^ 0x7F7F7F7FUL;
+        if((((word - 0x20202020UL) & ~word) | ((del - 0x01010101UL) & ~del)) & 0x80808080UL){
+            break;
+        }
+        i += 4;
+    }
+    while(i < length && data[i] >= 0x20 && data[i] != 0x7F){
+        i++;
+    }
+    return i;
+}
+
+/**
+ * @brief Append characters to the current line and echo them
+ *
+ * Characters beyond the command buffer are dropped and mark the line as
+ * overflowed.
+ */
+static void cdc_usb_line_append(const uint8_t *data, uint16_t length){
+    uint16_t room = (APP_READ_BUFFER_SIZE - 1) - command_index;
+    if(length > room){
+        length = room;
+        command_overflow = true;
+    }
+    if(length != 0){
+        memcpy(&commandBuffer[command_index], data, length);
+        command_index += length;
+        if(command_echo){
+            cdc_usb_write_bytes(data, length);
+        }
+    }
+}
+
+/**
+ * @brief Run the line discipline over one received buffer
+ *
+ * @return Bytes consumed, less than length when a line could not be queued
+ */
+static uint16_t cdc_usb_parse(const uint8_t *data, uint16_t length){
+    uint16_t i = 0;
+    while(i < length){
+        uint16_t run = cdc_usb_scan(&data[i], length - i);
+        if(run != 0){
+            cdc_usb_line_append(&data[i], run);
+            i += run;
+            continue;
+        }
+        uint8_t character = data[i];
+        if(character == CDC_USB_LINE_TERMINATOR && !command_overflow &&
+           (uint8_t)(cdcLines.head - __atomic_load_n(&cdcLines.tail, __ATOMIC_ACQUIRE)) == CDC_USB_LINE_QUEUE){
+            return i;   // The line queue is full; resume at the terminator
+        }
+        i++;
         // Process termination
-        if (usbState.cdcReadBuffer[i] == CDC_USB_LINE_TERMINATOR)
+        if (character == CDC_USB_LINE_TERMINATOR)
+        {
+            if(command_overflow){
+                line_received++;
+                usbState.rxOverflows++;
+                command_overflow = false;
+                command_index = 0;
+                cdc_usb_write_buffer(CDC_USB_LINE_OVERFLOW_RESPONSE,
+                                     sizeof(CDC_USB_LINE_OVERFLOW_RESPONSE) - 1, NULL, NULL);
+            } else {
+                commandBuffer[command_index] = '\0'; // Null-terminate the command
+                cdc_usb_return_line();
+            }
+        }
+        // Line feeds of CR LF input are dropped, NUL bytes too since they
+        // would end the line early and delimit binary frames in the output
+        else if (character == '\n' || character == '\0')
         {
-            commandBuffer[command_index] = '\0'; // Null-terminate the command
-            cdc_usb_return_line();
-            break;
         }
         // Process reset characters
-        else if (usbState.cdcReadBuffer[i] == CDC_USB_RESET_LINE_CHAR_1 || usbState.cdcReadBuffer[i] == CDC_USB_RESET_LINE_CHAR_2)
+        else if (character == CDC_USB_RESET_LINE_CHAR_1 || character == CDC_USB_RESET_LINE_CHAR_2)
         {
             command_index = 0;
-            sprintf(receivedBuffer, CDC_USB_RESET_LINE_RESPONSE);
-            break;
+            command_overflow = false;
+            if(command_echo){
+                cdc_usb_write_buffer(CDC_USB_RESET_LINE_RESPONSE,
+                                     sizeof(CDC_USB_RESET_LINE_RESPONSE) - 1, NULL, NULL);
+            }
+        }
+        // Process backspace characters
+        else if (character == CDC_USB_BACKSPACE_CHAR_1 || character == CDC_USB_BACKSPACE_CHAR_2)
+        {
+            if(command_index > 0 && !command_overflow){
+                command_index--;
+                if(command_echo){
+                    cdc_usb_write_buffer(CDC_USB_BACKSPACE_RESPONSE,
+                                         sizeof(CDC_USB_BACKSPACE_RESPONSE) - 1, NULL, NULL);
+                }
+            }
         }
-        // Regular character processing
+        // Other control characters are kept as regular characters
         else
         {
-            commandBuffer[command_index] = usbState.cdcReadBuffer[i];
-            command_index++;
-            receivedBuffer[i] = usbState.cdcReadBuffer[i];
+            cdc_usb_line_append(&data[i - 1], 1);
+        }
+    }
+    return i;
+}
+
+void cdc_usb_read_line(void){
+    for(;;){
+        if(__atomic_exchange_n(&cdcRx.parsing, true, __ATOMIC_ACQUIRE)){
+            cdcRx.kick = true;
+            return;
+        }
+        cdcRx.kick = false;
+
+        // Hand the completed buffers to the parser in order; the other reads
+        // stay posted meanwhile
+        uint8_t generation = cdcRx.generation;
+        while(__atomic_load_n(&cdcRx.slotsFilled, __ATOMIC_ACQUIRE) != 0){
+            uint8_t slot = cdcRx.slotParse;
+            uint16_t offset = cdcRx.offset;
+            offset += cdc_usb_parse(&cdcReadBuffer[slot][offset], cdcRx.length[slot] - offset);
+            if(generation != cdcRx.generation){
+                break;          // The port was opened again meanwhile
+            }
+            if(offset != cdcRx.length[slot]){
+                cdcRx.offset = offset;
+                break;          // Held until cdc_usb_line_task() frees a line
+            }
+            cdcRx.offset = 0;
+            cdcRx.slotParse = (slot + 1 == CDC_USB_RX_IRPS) ? 0 : slot + 1;
+            if(__atomic_sub_fetch(&cdcRx.slotsFilled, 1, __ATOMIC_ACQ_REL) == 0){
+                usbState.isReadComplete = false;
+                usbState.numBytesRead = 0;
+            }
+            cdc_usb_rx_post(slot);
+        }
+
+        __atomic_store_n(&cdcRx.parsing, false, __ATOMIC_RELEASE);
+        if(!cdcRx.kick){
+            return;
         }
     }
-    usbState.isReadComplete = false;
-    usbState.numBytesRead = 0;
-    USB_DEVICE_CDC_Read (USB_DEVICE_CDC_INDEX_0,
-                    &usbState.readTransferHandle, usbState.cdcReadBuffer,
-                    APP_READ_BUFFER_SIZE);
-    cdc_usb_write(receivedBuffer);
 }
 
 void cdc_usb_return_line_callback_register(void (*callback)(char*)){
@@ -262,39 +848,121 @@ void cdc_usb_return_line_callback_unregister(void){
 }
 
 void cdc_usb_return_line(void){
-	// Call the registered callback function with the command buffer
-	if (return_line_callback != NULL) {
-		return_line_callback(commandBuffer);
-	}
+	// Queue the command buffer; cdc_usb_read_line() checked for room
+	uint8_t head = cdcLines.head;
+	memcpy(cdcLines.text[head & CDC_USB_LINE_MASK], commandBuffer, command_index + 1U);
+	cdcLines.number[head & CDC_USB_LINE_MASK] = line_received++;
+	cdcLines.generation[head & CDC_USB_LINE_MASK] = cdcRx.generation;
+	__atomic_store_n(&cdcLines.head, (uint8_t)(head + 1), __ATOMIC_RELEASE);
 	
 	// Reset the command index and buffer for the next command
 	command_index = 0;
     commandBuffer[0] = '\0';
 }
 
+void cdc_usb_line_task(void){
+    uint8_t tail = cdcLines.tail;
+    if(tail == __atomic_load_n(&cdcLines.head, __ATOMIC_ACQUIRE)){
+        return;
+    }
+    do {
+        uint8_t slot = tail & CDC_USB_LINE_MASK;
+        if(cdcLines.generation[slot] == cdcRx.generation){
+            line_delivered = cdcLines.number[slot];
+            if(return_line_callback != NULL){
+                return_line_callback(cdcLines.text[slot]);
+            }
+        }
+        tail++;
+        __atomic_store_n(&cdcLines.tail, tail, __ATOMIC_RELEASE);
+    } while(tail != __atomic_load_n(&cdcLines.head, __ATOMIC_ACQUIRE));
+    // Resume a parse held back by the full queue
+    cdc_usb_read_line();
+}
+
+uint16_t cdc_usb_line_number(void){
+    return line_delivered;
+}
+
 bool cdc_usb_write(char *data){
     // Write data to the USB CDC interface
     if(data == NULL || data[0] == '\0'){
         return false;
     }
-    if(usbState.isConfigured == false || usbState.isWriteComplete == false){
+    return cdc_usb_write_bytes(data, strlen(data));
+}
+
+bool cdc_usb_write_bytes(const void *data, size_t length){
+    return cdc_usb_write_flags(data, length, CDC_USB_WRITE_COALESCE);
+}
+
+bool cdc_usb_write_flags(const void *data, size_t length, cdc_usb_write_flags_t flags){
+    if(data == NULL || length == 0 || length > CDC_USB_TX_LENGTH){
         return false;
     }
-    sprintf((char* )usbState.cdcWriteBuffer, "%s", data);
-    usbState.isWriteComplete = false;
-    usbState.writeTransferHandle =  USB_DEVICE_CDC_TRANSFER_HANDLE_INVALID;
-    USB_DEVICE_CDC_RESULT result;
-    result = USB_DEVICE_CDC_Write(USB_DEVICE_CDC_INDEX_0,
-                    &usbState.writeTransferHandle,
-                    usbState.cdcWriteBuffer, strlen((char *)usbState.cdcWriteBuffer),
-                    USB_DEVICE_CDC_TRANSFER_FLAGS_DATA_COMPLETE);
-    if (result != USB_DEVICE_CDC_RESULT_OK)
-    {
+    if(usbState.isConfigured == false){
+        return false;
+    }
+    uint16_t position;
+    if(!cdc_usb_tx_reserve(CDC_USB_TX_HEADER_SIZE + length, &position)){
+        return false;
+    }
+    uint8_t header[CDC_USB_TX_HEADER_SIZE] = { (uint8_t)length, (uint8_t)(length >> 8) };
+    cdc_usb_tx_put(position, header, sizeof(header));
+    cdc_usb_tx_put(position + CDC_USB_TX_HEADER_SIZE, data, length);
+    cdc_usb_tx_commit((flags & CDC_USB_WRITE_BYPASS) != 0);
+    return true;
+}
+
+bool cdc_usb_write_buffer(const void *data, size_t length, cdc_usb_write_done_t done, void *context){
+    cdc_usb_segment_t segment = { data, length };
+    return cdc_usb_write_segments(&segment, 1, done, context);
+}
+
+bool cdc_usb_write_segments(const cdc_usb_segment_t *segments, uint8_t count,
+                            cdc_usb_write_done_t done, void *context){
+    if(segments == NULL || count == 0 || count > CDC_USB_TX_MAX_SEGMENTS){
+        return false;
+    }
+    for(uint8_t i = 0; i < count; i++){
+        if(segments[i].data == NULL && segments[i].length != 0){
+            return false;
+        }
+    }
+    if(usbState.isConfigured == false){
         return false;
     }
+    uint16_t position;
+    if(!cdc_usb_tx_reserve(CDC_USB_TX_REF_SIZE(count), &position)){
+        return false;
+    }
+    uint8_t header[CDC_USB_TX_HEADER_SIZE] = { count, (uint8_t)(CDC_USB_TX_REFERENCE >> 8) };
+    cdc_usb_tx_put(position, header, sizeof(header));
+    cdc_usb_tx_put(position + CDC_USB_TX_HEADER_SIZE, &done, sizeof(done));
+    cdc_usb_tx_put(position + CDC_USB_TX_HEADER_SIZE + sizeof(done), &context, sizeof(context));
+    cdc_usb_tx_put(position + CDC_USB_TX_REF_SIZE(0), segments, count * sizeof(cdc_usb_segment_t));
+    cdc_usb_tx_commit(false);
     return true;
 }
 
+void cdc_usb_set_coalescing(bool enable){
+    cdcTx.coalesce = enable;
+    if(!enable){
+        cdc_usb_flush();
+    }
+}
+
+void cdc_usb_flush(void){
+    cdcTx.flush = true;
+    if(CDC_USB_TX_WRITERS(__atomic_load_n(&cdcTx.reserve, __ATOMIC_ACQUIRE)) == 0){
+        cdc_usb_tx_drain();
+    }
+}
+
+void cdc_usb_set_echo(bool enable){
+    command_echo = enable;
+}
+
 void cdc_usb_console_ready_callback_register(void (*callback)(void)){
 	// Register a callback function to be called when the console is ready
 	console_ready_callback = callback;
@@ -32,13 +32,32 @@ extern "C" {
 
 //! @brief Read buffer size for CDC USB operations
 #define APP_READ_BUFFER_SIZE 512
+//! @brief Read transfers kept posted, must match queueSizeRead in usb_device_init_data.c
+#define CDC_USB_RX_IRPS 3
+//! @brief Size of the transmit ring in bytes (power of two, at most 32768)
+#define CDC_USB_TX_RING_SIZE 2048
+//! @brief Write transfers kept in flight, must match queueSizeWrite in usb_device_init_data.c
+#define CDC_USB_TX_IRPS 3
+//! @brief Largest write transfer (multiple of the 64-byte bulk packet size)
+#define CDC_USB_TX_IRP_SIZE 512
+//! @brief Most segments accepted by one cdc_usb_write_segments() call
+#define CDC_USB_TX_MAX_SEGMENTS 8
+//! @brief Received lines queued for cdc_usb_line_task() (power of two)
+#define CDC_USB_LINE_QUEUE 4
 //! @brief Line terminator character for command input
 #define CDC_USB_LINE_TERMINATOR '\r'
 //! @brief Reset line message
 #define CDC_USB_RESET_LINE_RESPONSE "\n\rReset line\r\n"
-//! @brief Reset line characters
+//! @brief Reset line characters (Ctrl+G and Ctrl+U)
 #define CDC_USB_RESET_LINE_CHAR_1 7
-#define CDC_USB_RESET_LINE_CHAR_2 8
+#define CDC_USB_RESET_LINE_CHAR_2 21
+//! @brief Backspace characters (Backspace and Delete)
+#define CDC_USB_BACKSPACE_CHAR_1 8
+#define CDC_USB_BACKSPACE_CHAR_2 127
+//! @brief Echo that erases the last character on the terminal
+#define CDC_USB_BACKSPACE_RESPONSE "\b \b"
+//! @brief Message sent when a line longer than the command buffer is discarded
+#define CDC_USB_LINE_OVERFLOW_RESPONSE "\r\nLine too long\r\n"
 
 /* Initial get line coding state */
 //! @brief Default Data Terminal Rate (baud rate) for CDC USB
@@ -86,8 +105,49 @@ typedef struct
     uint8_t * cdcWriteBuffer;
     /** @brief Number of bytes read from Host in last operation */ 
     uint32_t numBytesRead; 
+    /** @brief Writes rejected because the transmit ring was full */
+    uint32_t txOverflows;
+    /** @brief Lines discarded because they did not fit in the command buffer */
+    uint32_t rxOverflows;
+    /** @brief Write transfers started */
+    uint32_t txTransfers;
+    /** @brief Bulk packets sent, including zero-length packets */
+    uint32_t txPackets;
+    /** @brief Bytes sent */
+    uint32_t txBytes;
 } cdc_usb_t;
 
+/**
+ * @brief One caller-owned buffer of a scatter-gather write
+ */
+typedef struct
+{
+    /** @brief Data to transmit, may contain NUL bytes */
+    const void * data;
+    /** @brief Number of bytes to transmit */
+    size_t length;
+} cdc_usb_segment_t;
+
+/**
+ * @brief Options of cdc_usb_write_flags()
+ */
+typedef enum
+{
+    /** @brief Follow the coalescing mode */
+    CDC_USB_WRITE_COALESCE = 0,
+    /** @brief Start the transfer now, together with everything queued before */
+    CDC_USB_WRITE_BYPASS = 0x01
+} cdc_usb_write_flags_t;
+
+/**
+ * @brief Completion callback of a zero-copy write
+ *
+ * Called once the buffers of the write have been sent, or dropped because
+ * the device was reset, and may be reused. Usually runs in the USB
+ * interrupt context.
+ */
+typedef void (*cdc_usb_write_done_t)(void *context);
+
 /**
  * @brief Initializes the CDC USB platform
  * 
@@ -154,44 +214,160 @@ cdc_usb_t* get_cdc_usb_handle(void);
 /**
  * @brief Writes a null-terminated string to the CDC USB interface
  *
- * This function transmits a string over the USB CDC interface. It validates
- * the input data and device state, then copies the data to the internal write
- * buffer and initiates an asynchronous USB transfer. The function checks that
- * the device is configured and no other write operation is currently in progress.
+ * This function queues a string for transmission over the USB CDC interface.
+ * The string is copied into a transmit ring and the function returns
+ * immediately; the ring is drained into up to CDC_USB_TX_IRPS outstanding
+ * USB write transfers, and each completed transfer starts the next one from
+ * the USB_DEVICE_CDC_EVENT_WRITE_COMPLETE event.
  * 
- * If the device is not configured or another write operation is already in
- * progress, the function returns false immediately without blocking.
+ * The function may be called from the main loop and from interrupt handlers
+ * at the same time: space in the ring is reserved with an atomic
+ * compare-and-swap and no interrupts are disabled.
  * 
  * @param data The null-terminated string to transmit (must not be NULL or empty)
- * @return true if the write operation was successfully initiated
- * @return false if the operation failed (NULL/empty data, device not configured, 
- *               write in progress, or USB transfer error)
- * 
- * @note This function does NOT block - it returns false if a write is already in progress
- * @note The function performs internal buffering using sprintf
- * @note The write operation is asynchronous - completion is signaled via USB events
- * @note Check the return value to ensure the write was successfully initiated
+ * @return true if the whole string was queued
+ * @return false if the operation failed (NULL/empty data, device not configured,
+ *               or not enough space in the transmit ring)
+ * 
+ * @note This function does NOT block; a string that does not fit is not queued
+ *       at all and counted in txOverflows
+ * @note The data is copied, so the caller's buffer may be reused immediately
  */
 bool cdc_usb_write(char* data);
 
+/**
+ * @brief Queues a block of binary data for transmission
+ *
+ * Same as cdc_usb_write() but takes an explicit length, so the data may
+ * contain NUL bytes. The data is copied into the transmit ring.
+ *
+ * @param data Bytes to transmit
+ * @param length Number of bytes, at most the free space of the transmit ring
+ * @return true if the whole block was queued
+ * @return false if the data is invalid, the device is not configured or the
+ *               ring has no room (counted in txOverflows)
+ */
+bool cdc_usb_write_bytes(const void* data, size_t length);
+
+/**
+ * @brief Queues a block of binary data with transmit options
+ *
+ * Same as cdc_usb_write_bytes(). With CDC_USB_WRITE_BYPASS the write does
+ * not wait for the next frame in coalescing mode; since the order of the
+ * writes is kept, the data queued before it is sent along.
+ *
+ * @param data Bytes to transmit
+ * @param length Number of bytes, at most the free space of the transmit ring
+ * @param flags CDC_USB_WRITE_COALESCE or CDC_USB_WRITE_BYPASS
+ * @return true if the whole block was queued
+ * @return false if the data is invalid, the device is not configured or the
+ *               ring has no room (counted in txOverflows)
+ */
+bool cdc_usb_write_flags(const void* data, size_t length, cdc_usb_write_flags_t flags);
+
+/**
+ * @brief Enables or disables write coalescing
+ *
+ * In coalescing mode the writes are collected in the transmit ring instead
+ * of each starting a USB transfer. The collected data is sent when a full
+ * transfer (CDC_USB_TX_IRP_SIZE bytes) is queued, on the next start of
+ * frame (every 1 ms, USB_DEVICE_EVENT_SOF), on cdc_usb_flush() or on a
+ * CDC_USB_WRITE_BYPASS write. Many small writes then share bulk packets.
+ * Disabling the mode flushes the ring. Coalescing is disabled by default.
+ *
+ * @param enable true to collect writes until the next frame
+ * @note Requires USB_DEVICE_SOF_EVENT_ENABLE in configuration.h
+ */
+void cdc_usb_set_coalescing(bool enable);
+
+/**
+ * @brief Starts transfers for everything queued in the transmit ring
+ */
+void cdc_usb_flush(void);
+
+/**
+ * @brief Enables or disables the echo of received characters
+ *
+ * With echo disabled the line discipline still handles backspace and reset
+ * characters but sends nothing back, so the host only receives the
+ * responses of its commands. Echo is enabled by default.
+ *
+ * @param enable true to echo characters, backspaces and line resets
+ */
+void cdc_usb_set_echo(bool enable);
+
+/**
+ * @brief Queues a caller-owned buffer for transmission without copying it
+ *
+ * Only a small descriptor goes into the transmit ring; the USB transfer
+ * reads straight from the buffer, which may be a const string in flash. The
+ * write keeps its place in the order of all other writes.
+ *
+ * @param data Bytes to transmit, left untouched until done is called
+ * @param length Number of bytes
+ * @param done Called when the buffer can be reused, may be NULL
+ * @param context Passed to done
+ * @return true if the buffer was queued
+ * @return false if the data is invalid, the device is not configured or the
+ *               ring has no room (counted in txOverflows); done is not called
+ */
+bool cdc_usb_write_buffer(const void* data, size_t length, cdc_usb_write_done_t done, void* context);
+
+/**
+ * @brief Queues a scatter-gather list of caller-owned buffers
+ *
+ * The segments are sent back to back without being copied, each as one USB
+ * write transfer; empty segments are skipped. No other write can be placed
+ * between them.
+ *
+ * @param segments List of buffers, only read during the call
+ * @param count Number of segments (1 to CDC_USB_TX_MAX_SEGMENTS)
+ * @param done Called once when all the buffers can be reused, may be NULL
+ * @param context Passed to done
+ * @return true if the segments were queued
+ * @return false if the list is invalid, the device is not configured or the
+ *               ring has no room (counted in txOverflows); done is not called
+ */
+bool cdc_usb_write_segments(const cdc_usb_segment_t* segments, uint8_t count,
+                            cdc_usb_write_done_t done, void* context);
+
 /**
  * @brief Processes received data for line-based input
  *
- * This function handles character-by-character processing of received USB data
- * to build complete command lines. It processes special characters and manages
- * the command buffer:
- * 
- * - Line terminator (CDC_USB_LINE_TERMINATOR): Triggers line completion and callback execution
+ * This function runs the line discipline over the received USB data. It is
+ * incremental: a line may span any number of packets and a packet may hold
+ * several lines. Runs of printable characters are found a 32-bit word at a
+ * time, appended to the command buffer and echoed straight from the received
+ * buffer; control characters are handled one by one:
+ * 
+ * - Line terminator (CDC_USB_LINE_TERMINATOR): Queues the line for cdc_usb_line_task()
+ * - Line feed: Ignored, so CR LF terminated input gives one line
+ * - NUL: Ignored, zero bytes delimit binary frames in the output (cdc_frame.h)
  * - Reset characters (CDC_USB_RESET_LINE_CHAR_1/2): Resets the current command buffer and sends reset message
+ * - Backspace characters (CDC_USB_BACKSPACE_CHAR_1/2): Remove the last character of the line
  * - All other characters: Added to command buffer and echoed back to host
  * 
- * The function automatically sets up the next USB read operation after processing
- * the current data. It should be called from the CDC event handler when read
- * completion events occur.
+ * A line longer than APP_READ_BUFFER_SIZE - 1 characters is not truncated
+ * silently: the excess is neither stored nor echoed, and when the terminator
+ * arrives the whole line is discarded, CDC_USB_LINE_OVERFLOW_RESPONSE is sent
+ * and rxOverflows is incremented.
+ * 
+ * Up to CDC_USB_RX_IRPS read transfers are kept posted over a pool of
+ * buffers. Completed buffers are parsed in the order they were received, and
+ * each buffer is posted again as soon as it has been parsed, so the host is
+ * not held off while the parser runs. It should be called from the CDC event
+ * handler when read completion events occur.
+ * 
+ * Completed lines wait in a queue of CDC_USB_LINE_QUEUE lines. When the
+ * queue is full the parser stops at the terminator and keeps the buffer, so
+ * the host is held off instead of losing lines; cdc_usb_line_task() resumes
+ * it once a line has been consumed. A call that finds the parser running,
+ * e.g. from the interrupt while the main loop resumes it, leaves the work to
+ * the running instance.
  * 
  * @note This function is called internally by the CDC event handler
  * @note Characters are echoed back to provide visual feedback to the user
- * @note The function handles buffer management and sets up the next read transfer
+ * @note The function handles buffer management and posts the read transfers again
  * @note Reset characters trigger sending of CDC_USB_RESET_LINE_RESPONSE
  */
 void cdc_usb_read_line(void);
@@ -212,10 +388,11 @@ void cdc_usb_read_line(void);
  *                 The callback receives the null-terminated command string.
  *                 Pass NULL to unregister the current callback.
  * 
- * @note The callback is executed from the USB event handler context
- * @note The command string passed to the callback is valid only during the callback execution
- * @note If more complex processing is needed, copy the command to a local buffer
- * @note The command buffer is automatically cleared after callback execution
+ * @note The callback is executed by cdc_usb_line_task(), in the main loop
+ * @note The command string passed to the callback is valid only during the callback
+ *       execution; the callback may modify it, e.g. to tokenize it in place
+ * @note Lines are delivered one at a time and in order, so a command can be run
+ *       directly from the callback
  * 
  * @see cdc_usb_return_line_callback_unregister()
  */
@@ -235,24 +412,47 @@ void cdc_usb_return_line_callback_register(void (*callback)(char*));
 void cdc_usb_return_line_callback_unregister(void);
 
 /**
- * @brief Executes the registered line callback and resets the command buffer
+ * @brief Queues the current line and resets the command buffer
  *
  * This function is called internally when a complete line is received (when
  * a carriage return character is processed). It performs the following actions:
  * 
- * 1. Executes the registered callback function (if any) with the current command buffer
+ * 1. Copies the current command buffer into the line queue
  * 2. Resets the command index to 0
- * 3. Clears the entire command buffer for the next command
+ * 3. Clears the command buffer for the next command
  * 
  * This function should not be called directly by user code - it is automatically
- * invoked by the line processing logic in cdc_usb_read_line().
+ * invoked by the line processing logic in cdc_usb_read_line(), which checks
+ * that the queue has room first.
  * 
  * @note This function is for internal use only
- * @note The command buffer is automatically cleared after callback execution
  * @see cdc_usb_read_line()
+ * @see cdc_usb_line_task()
  */
 void cdc_usb_return_line(void);
 
+/**
+ * @brief Delivers the received lines to the line callback
+ *
+ * Call from the main loop. Passes every queued line, oldest first, to the
+ * callback registered with cdc_usb_return_line_callback_register(), then
+ * resumes the parser if it was held back by a full queue. Lines received
+ * before the port was last opened are dropped.
+ */
+void cdc_usb_line_task(void);
+
+/**
+ * @brief Gets the number of the line last passed to the line callback
+ *
+ * Lines are numbered from 0 in the order their terminator was received
+ * since the port was opened. A line discarded as too long takes a number
+ * too, so the gap it leaves shows that a line was lost.
+ *
+ * @return uint16_t Number of the line being or last delivered, 0xFFFF
+ *         before the first line
+ */
+uint16_t cdc_usb_line_number(void);
+
 /**
  * @brief Registers a callback function for console ready notification
  *
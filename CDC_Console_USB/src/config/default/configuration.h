@@ -100,7 +100,7 @@ extern "C" {
 /* CDC Transfer Queue Size for both read and
    write. Applicable to all instances of the
    function driver */
-#define USB_DEVICE_CDC_QUEUE_DEPTH_COMBINED                 3U
+#define USB_DEVICE_CDC_QUEUE_DEPTH_COMBINED                 7U
 
 /*** USB Driver Configuration ***/
 
@@ -132,6 +132,9 @@ extern "C" {
 /* EP0 size in bytes */
 #define USB_DEVICE_EP0_BUFFER_SIZE                          64U
 
+/* Enable SOF Events */
+#define USB_DEVICE_SOF_EVENT_ENABLE
+
 
 
 
@@ -52,8 +52,8 @@
 /* MISRA C-2012 Rule 10.3 deviated:4 Deviation record ID -  H3_USB_MISRAC_2012_R_10_3_DR_1 */
 static const USB_DEVICE_CDC_INIT cdcInit0 =
 {
-    .queueSizeRead = 1,
-    .queueSizeWrite = 1,
+    .queueSizeRead = 3,
+    .queueSizeWrite = 3,
     .queueSizeSerialStateNotification = 1
 };
 /* MISRAC 2012 deviation block end */   
@@ -22,11 +22,15 @@
 // *****************************************************************************
 // *****************************************************************************
 
-#include <cstdio>
 #include <stddef.h>                     // Defines NULL
 #include <stdbool.h>                    // Defines true
 #include <stdlib.h>                     // Defines EXIT_FAILURE
 #include "definitions.h"                // SYS function prototypes
+#include "../CDC_USB/cdc_command.h"
+#include "../CDC_USB/cdc_format.h"
+#include "../CDC_USB/cdc_frame.h"
+#include "../CDC_USB/cdc_log.h"
+#include "../CDC_USB/cdc_telemetry.h"
 
 #include "string.h"
 
@@ -36,29 +40,75 @@
 // *****************************************************************************
 // *****************************************************************************
 
-bool commandAvailable = false;
-char command[APP_READ_BUFFER_SIZE];
+#define STREAM_CHANNEL 0
+#define STREAM_SAMPLES (CDC_FRAME_PAYLOAD_MAX / sizeof(uint16_t))
 
-char consoleMenu[] = {
+bool streaming = false;
+uint16_t streamSamples[STREAM_SAMPLES];
+uint16_t streamValue = 0;
+volatile uint32_t uptimeMs = 0;         // Counted by SysTick_Handler
+
+const char consoleMenu[] = {
 "       Console over USB CDC\r\n"
 "Type a command followed by [ENTER]:\r\n"
-"Turn on led\r\n"
-"Turn off led\r\n"
-"Toggle led\r\n"
+"led on|off|toggle\r\n"
+"mode interactive|machine\r\n"
+"stream on|off\r\n"
+"status\r\n"
+"sources\r\n"
+"sub <source> <period_ms>\r\n"
+"unsub <source>|all\r\n"
+"help\r\n"
 "\r\n"
 };
 
 void ReadLine( char* data );
 void ConsoleReady(void);
 void DecodeCommand(char * command);
+bool LedCommand(const cdc_command_args_t *args);
+bool HelpCommand(const cdc_command_args_t *args);
+bool ModeCommand(const cdc_command_args_t *args);
+bool StreamCommand(const cdc_command_args_t *args);
+bool StatusCommand(const cdc_command_args_t *args);
+void StreamTask(void);
+int32_t LedSource(void);
+int32_t StreamSource(void);
+int32_t TxBytesSource(void);
+int32_t TxOverflowsSource(void);
+int32_t RxOverflowsSource(void);
+
+static const cdc_command_t consoleCommands[] = {
+    CDC_COMMAND("led", LedCommand, "led on|off|toggle"),
+    CDC_COMMAND("mode", ModeCommand, "mode interactive|machine"),
+    CDC_COMMAND("stream", StreamCommand, "stream on|off"),
+    CDC_COMMAND("status", StatusCommand, "status"),
+    CDC_COMMAND("help", HelpCommand, "help"),
+};
+
+static const cdc_telemetry_source_t telemetrySources[] = {
+    { "led", LedSource },
+    { "stream", StreamSource },
+    { "tx_bytes", TxBytesSource },
+    { "tx_overflows", TxOverflowsSource },
+    { "rx_overflows", RxOverflowsSource },
+};
 
 int main ( void )
 {
     /* Initialize all modules */
     SYS_Initialize ( NULL );
+    cdc_log_initialize();
     cdc_usb_return_line_callback_register(ReadLine);
     cdc_usb_console_ready_callback_register(ConsoleReady);
+    cdc_command_register(consoleCommands, sizeof(consoleCommands) / sizeof(consoleCommands[0]));
+    cdc_telemetry_initialize();
+    cdc_telemetry_register(telemetrySources, sizeof(telemetrySources) / sizeof(telemetrySources[0]));
+    // 1 ms period; the interrupt counts the ticks so none is lost while a
+    // loop pass takes longer than a period
+    SYSTICK_TimerPeriodSet(SYSTICK_TimerFrequencyGet() / 1000U);
     SYSTICK_TimerStart();
+    SysTick->CTRL |= SysTick_CTRL_TICKINT_Msk;
+    uint32_t telemetryMs = 0;
     uint16_t delay = 0;
     
     while ( true )
@@ -66,9 +116,13 @@ int main ( void )
         if(delay++ == 0xFFFF){
             GPIO_PA16_Toggle();
         }
-        if(commandAvailable){
-            commandAvailable = false;
-            DecodeCommand(command);
+        cdc_usb_line_task();
+        StreamTask();
+        cdc_log_task();
+        // Catch up on the ticks that elapsed during the pass
+        while(telemetryMs != uptimeMs){
+            telemetryMs++;
+            cdc_telemetry_tick();
         }
         /* Maintain state machines of all polled MPLAB Harmony modules. */
         SYS_Tasks ( );
@@ -84,36 +138,153 @@ int main ( void )
  End of File
 */
 
+extern "C" void SysTick_Handler(void){
+    // Overrides the weak handler of interrupts.c
+    uptimeMs++;
+}
+
 void ReadLine( char* data ){
+    // Called from cdc_usb_line_task(), one line at a time, so the line is
+    // run in place
     if(data == NULL || data[0] == '\0'){
         return;
     }
-    commandAvailable = true;
-    sprintf(command, "%s", data);
+    DecodeCommand(data);
 }
 
 void ConsoleReady(void){
-    cdc_usb_write(consoleMenu);
+    // A new terminal session always starts interactive and not streaming
+    CDC_LOG("console ready");
+    streaming = false;
+    cdc_log_set_output(false);
+    cdc_telemetry_unsubscribe_all();
+    cdc_command_set_mode(CDC_COMMAND_MODE_INTERACTIVE);
+    cdc_usb_write_buffer(consoleMenu, sizeof(consoleMenu) - 1, NULL, NULL);
 }
 
 void DecodeCommand(char * command){
-    char txBuffer[256] = {0};
-    if(command == NULL || command[0] == '\0'){
+    cdc_command_result_t result = cdc_command_dispatch(command);
+    if(result == CDC_COMMAND_EMPTY){
+        return;
+    }
+    if(result != CDC_COMMAND_OK){
+        CDC_LOG("command rejected: result %d", result);
+    }
+    if(cdc_command_get_mode() == CDC_COMMAND_MODE_MACHINE){
         return;
     }
-    if(strcmp(command, "Turn on led") == 0){
+    // The menu lives in flash, so it is sent without being copied
+    cdc_usb_segment_t reply[] = {
+        { "\r\n", 2 },
+        { consoleMenu, sizeof(consoleMenu) - 1 },
+    };
+    cdc_usb_write_segments(reply, 2, NULL, NULL);
+}
+
+bool LedCommand(const cdc_command_args_t *args){
+    const char * response;
+    if(args->argc != 2){
+        return false;
+    }
+    if(strcmp(args->argv[1], "on") == 0){
         GPIO_PB06_Clear();
-        sprintf(txBuffer, "\r\nled is on\r\n");
-    } else if(strcmp(command, "Turn off led") == 0){
+        response = "led is on";
+    } else if(strcmp(args->argv[1], "off") == 0){
         GPIO_PB06_Set();
-        sprintf(txBuffer, "\r\nled is off\r\n");
-    } else if(strcmp(command, "Toggle led") == 0){
+        response = "led is off";
+    } else if(strcmp(args->argv[1], "toggle") == 0){
         GPIO_PB06_Toggle();
-        sprintf(txBuffer, "\r\nled is toggled\r\n");
+        response = "led is toggled";
     } else {
-        sprintf(txBuffer, "\r\nUnknown command\r\n");
+        return false;
+    }
+    cdc_command_respond(response);
+    return true;
+}
+
+bool HelpCommand(const cdc_command_args_t *args){
+    // The menu follows every interactive command, so there is nothing more to send
+    return args->argc == 1;
+}
+
+bool ModeCommand(const cdc_command_args_t *args){
+    if(args->argc != 2){
+        return false;
+    }
+    if(strcmp(args->argv[1], "interactive") == 0){
+        cdc_command_set_mode(CDC_COMMAND_MODE_INTERACTIVE);
+    } else if(strcmp(args->argv[1], "machine") == 0){
+        cdc_command_set_mode(CDC_COMMAND_MODE_MACHINE);
+    } else {
+        return false;
+    }
+    // The log frames are binary, so they are only sent to scripts
+    cdc_log_set_output(cdc_command_get_mode() == CDC_COMMAND_MODE_MACHINE);
+    CDC_LOG("mode %u", cdc_command_get_mode());
+    return true;
+}
+
+bool StreamCommand(const cdc_command_args_t *args){
+    if(args->argc != 2){
+        return false;
     }
-    strcat(txBuffer, "\r\n");
-    strcat(txBuffer, consoleMenu);
-    cdc_usb_write(txBuffer);
-}
\ No newline at end of file
+    if(strcmp(args->argv[1], "on") == 0){
+        streaming = true;
+    } else if(strcmp(args->argv[1], "off") == 0){
+        streaming = false;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool StatusCommand(const cdc_command_args_t *args){
+    char text[48];
+    cdc_format_line_t line;
+    if(args->argc != 1){
+        return false;
+    }
+    // Uptime in seconds with millisecond resolution, e.g. "uptime 12.345 s"
+    cdc_format_line_init(&line, text, sizeof(text));
+    cdc_format_line_str(&line, "uptime ");
+    cdc_format_line_fixed(&line, (int32_t)(uptimeMs & INT32_MAX), 3);
+    cdc_format_line_str(&line, " s, tx ");
+    cdc_format_line_uint(&line, get_cdc_usb_handle()->txBytes);
+    cdc_format_line_str(&line, " bytes");
+    return cdc_command_respond(cdc_format_line_text(&line));
+}
+
+void StreamTask(void){
+    // Test pattern: a 16-bit ramp, one frame whenever a frame buffer beyond
+    // the ones reserved for telemetry and the log is free
+    if(!streaming || cdc_frame_free() <= CDC_FRAME_RESERVED){
+        return;
+    }
+    for(uint16_t i = 0; i < STREAM_SAMPLES; i++){
+        streamSamples[i] = streamValue + i;
+    }
+    if(cdc_frame_send(STREAM_CHANNEL, streamSamples, sizeof(streamSamples))){
+        streamValue += STREAM_SAMPLES;
+    }
+}
+
+int32_t LedSource(void){
+    // The LED is active low
+    return GPIO_PB06_Get() == 0U;
+}
+
+int32_t StreamSource(void){
+    return streamValue;
+}
+
+int32_t TxBytesSource(void){
+    return (int32_t)get_cdc_usb_handle()->txBytes;
+}
+
+int32_t TxOverflowsSource(void){
+    return (int32_t)get_cdc_usb_handle()->txOverflows;
+}
+
+int32_t RxOverflowsSource(void){
+    return (int32_t)get_cdc_usb_handle()->rxOverflows;
+}
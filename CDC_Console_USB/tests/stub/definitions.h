@@ -0,0 +1,128 @@
+/**
+ * @file definitions.h
+ * @brief Host stand-in for the MPLAB Harmony definitions used by CDC_USB
+ *
+ * Declares just the USB device and CDC function driver types and functions
+ * that cdc_usb_platform.c uses, so the platform layer builds with the host
+ * compiler. The functions are implemented by usb_stub.c, which records the
+ * posted reads and the writes instead of talking to a USB peripheral.
+ *
+ * @author Alejandro Beltran
+ * @date October 2026
+ */
+
+#ifndef _DEFINITIONS_H
+#define _DEFINITIONS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define CACHE_ALIGN __attribute__((aligned(16)))
+
+typedef uintptr_t USB_DEVICE_HANDLE;
+typedef uintptr_t USB_DEVICE_CDC_TRANSFER_HANDLE;
+typedef int USB_DEVICE_CDC_INDEX;
+
+#define USB_DEVICE_HANDLE_INVALID ((USB_DEVICE_HANDLE)(-1))
+#define USB_DEVICE_CDC_TRANSFER_HANDLE_INVALID ((USB_DEVICE_CDC_TRANSFER_HANDLE)(-1))
+#define USB_DEVICE_CDC_INDEX_0 0
+
+typedef enum
+{
+    USB_DEVICE_EVENT_SOF,
+    USB_DEVICE_EVENT_RESET,
+    USB_DEVICE_EVENT_DECONFIGURED,
+    USB_DEVICE_EVENT_CONFIGURED,
+    USB_DEVICE_EVENT_POWER_DETECTED,
+    USB_DEVICE_EVENT_POWER_REMOVED,
+    USB_DEVICE_EVENT_SUSPENDED,
+    USB_DEVICE_EVENT_RESUMED,
+    USB_DEVICE_EVENT_ERROR,
+} USB_DEVICE_EVENT;
+
+typedef enum
+{
+    USB_DEVICE_CDC_EVENT_GET_LINE_CODING,
+    USB_DEVICE_CDC_EVENT_SET_LINE_CODING,
+    USB_DEVICE_CDC_EVENT_SET_CONTROL_LINE_STATE,
+    USB_DEVICE_CDC_EVENT_SEND_BREAK,
+    USB_DEVICE_CDC_EVENT_READ_COMPLETE,
+    USB_DEVICE_CDC_EVENT_CONTROL_TRANSFER_DATA_RECEIVED,
+    USB_DEVICE_CDC_EVENT_CONTROL_TRANSFER_DATA_SENT,
+    USB_DEVICE_CDC_EVENT_WRITE_COMPLETE,
+} USB_DEVICE_CDC_EVENT;
+
+typedef enum
+{
+    USB_DEVICE_CDC_EVENT_RESPONSE_NONE,
+} USB_DEVICE_CDC_EVENT_RESPONSE;
+
+typedef enum
+{
+    USB_DEVICE_CDC_RESULT_OK,
+    USB_DEVICE_CDC_RESULT_ERROR,
+} USB_DEVICE_CDC_RESULT;
+
+typedef enum
+{
+    USB_DEVICE_CDC_TRANSFER_FLAGS_DATA_COMPLETE = 1,
+    USB_DEVICE_CDC_TRANSFER_FLAGS_MORE_DATA_PENDING = 2,
+} USB_DEVICE_CDC_TRANSFER_FLAGS;
+
+typedef enum
+{
+    USB_DEVICE_CONTROL_STATUS_OK,
+    USB_DEVICE_CONTROL_STATUS_ERROR,
+} USB_DEVICE_CONTROL_STATUS;
+
+typedef struct
+{
+    uint32_t dwDTERate;
+    uint8_t bCharFormat;
+    uint8_t bParityType;
+    uint8_t bDataBits;
+} USB_CDC_LINE_CODING;
+
+typedef struct
+{
+    unsigned dtr : 1;
+    unsigned carrier : 1;
+} USB_CDC_CONTROL_LINE_STATE;
+
+typedef struct
+{
+    uint8_t configurationValue;
+} USB_DEVICE_EVENT_DATA_CONFIGURED;
+
+typedef struct
+{
+    USB_DEVICE_CDC_TRANSFER_HANDLE handle;
+    size_t length;
+    USB_DEVICE_CDC_RESULT status;
+}
+USB_DEVICE_CDC_EVENT_DATA_WRITE_COMPLETE,
+USB_DEVICE_CDC_EVENT_DATA_READ_COMPLETE;
+
+typedef struct
+{
+    uint16_t breakDuration;
+} USB_DEVICE_CDC_EVENT_DATA_SEND_BREAK;
+
+typedef USB_DEVICE_CDC_EVENT_RESPONSE (*USB_DEVICE_CDC_EVENT_HANDLER)
+    (USB_DEVICE_CDC_INDEX index, USB_DEVICE_CDC_EVENT event, void *pData, uintptr_t userData);
+
+void USB_DEVICE_CDC_EventHandlerSet(USB_DEVICE_CDC_INDEX index,
+                                    USB_DEVICE_CDC_EVENT_HANDLER handler, uintptr_t userData);
+void USB_DEVICE_ControlSend(USB_DEVICE_HANDLE handle, void *data, size_t length);
+void USB_DEVICE_ControlReceive(USB_DEVICE_HANDLE handle, void *data, size_t length);
+void USB_DEVICE_ControlStatus(USB_DEVICE_HANDLE handle, USB_DEVICE_CONTROL_STATUS status);
+void USB_DEVICE_Attach(USB_DEVICE_HANDLE handle);
+void USB_DEVICE_Detach(USB_DEVICE_HANDLE handle);
+USB_DEVICE_CDC_RESULT USB_DEVICE_CDC_Read(USB_DEVICE_CDC_INDEX index,
+        USB_DEVICE_CDC_TRANSFER_HANDLE *handle, void *data, size_t length);
+USB_DEVICE_CDC_RESULT USB_DEVICE_CDC_Write(USB_DEVICE_CDC_INDEX index,
+        USB_DEVICE_CDC_TRANSFER_HANDLE *handle, const void *data, size_t length,
+        USB_DEVICE_CDC_TRANSFER_FLAGS flags);
+
+#endif /* _DEFINITIONS_H */
@@ -0,0 +1,154 @@
+/**
+ * @file usb_stub.c
+ * @brief Stub USB device layer recording reads and writes
+ *
+ * @author Alejandro Beltran
+ * @date October 2026
+ */
+
+#include "usb_stub.h"
+#include "../../CDC_USB/cdc_usb_platform.h"
+
+#define USB_STUB_QUEUE 8
+#define USB_STUB_OUTPUT_SIZE 65536
+
+static USB_DEVICE_CDC_EVENT_HANDLER stub_handler;
+static uintptr_t stub_user_data;
+
+static struct {
+    void *data[USB_STUB_QUEUE];
+    size_t size[USB_STUB_QUEUE];
+    uint8_t head;
+    uint8_t tail;
+} stub_reads;
+
+static size_t stub_writes;
+static bool stub_cancelling;
+static size_t stub_violations;
+static uint8_t stub_output[USB_STUB_OUTPUT_SIZE];
+static size_t stub_output_length;
+
+void USB_DEVICE_CDC_EventHandlerSet(USB_DEVICE_CDC_INDEX index,
+                                    USB_DEVICE_CDC_EVENT_HANDLER handler, uintptr_t userData){
+    (void)index;
+    stub_handler = handler;
+    stub_user_data = userData;
+}
+
+void USB_DEVICE_ControlSend(USB_DEVICE_HANDLE handle, void *data, size_t length){
+    (void)handle; (void)data; (void)length;
+}
+
+void USB_DEVICE_ControlReceive(USB_DEVICE_HANDLE handle, void *data, size_t length){
+    (void)handle; (void)data; (void)length;
+}
+
+void USB_DEVICE_ControlStatus(USB_DEVICE_HANDLE handle, USB_DEVICE_CONTROL_STATUS status){
+    (void)handle; (void)status;
+}
+
+void USB_DEVICE_Attach(USB_DEVICE_HANDLE handle){
+    (void)handle;
+}
+
+void USB_DEVICE_Detach(USB_DEVICE_HANDLE handle){
+    (void)handle;
+}
+
+USB_DEVICE_CDC_RESULT USB_DEVICE_CDC_Read(USB_DEVICE_CDC_INDEX index,
+        USB_DEVICE_CDC_TRANSFER_HANDLE *handle, void *data, size_t length){
+    (void)index;
+    if(stub_cancelling){
+        stub_violations++;
+        return USB_DEVICE_CDC_RESULT_ERROR;
+    }
+    if((uint8_t)(stub_reads.head - stub_reads.tail) == USB_STUB_QUEUE){
+        return USB_DEVICE_CDC_RESULT_ERROR;
+    }
+    stub_reads.data[stub_reads.head % USB_STUB_QUEUE] = data;
+    stub_reads.size[stub_reads.head % USB_STUB_QUEUE] = length;
+    *handle = stub_reads.head++;
+    return USB_DEVICE_CDC_RESULT_OK;
+}
+
+USB_DEVICE_CDC_RESULT USB_DEVICE_CDC_Write(USB_DEVICE_CDC_INDEX index,
+        USB_DEVICE_CDC_TRANSFER_HANDLE *handle, const void *data, size_t length,
+        USB_DEVICE_CDC_TRANSFER_FLAGS flags){
+    (void)index; (void)flags;
+    if(stub_cancelling){
+        stub_violations++;
+        return USB_DEVICE_CDC_RESULT_ERROR;
+    }
+    size_t room = USB_STUB_OUTPUT_SIZE - stub_output_length;
+    memcpy(&stub_output[stub_output_length], data, length < room ? length : room);
+    stub_output_length += length < room ? length : room;
+    *handle = stub_writes++;
+    return USB_DEVICE_CDC_RESULT_OK;
+}
+
+void usb_stub_configure(void){
+    USB_DEVICE_EVENT_DATA_CONFIGURED configured = { 1 };
+    stub_reads.tail = stub_reads.head;
+    stub_writes = 0;
+    APP_USBDeviceEventHandler(USB_DEVICE_EVENT_CONFIGURED, &configured, 0);
+}
+
+void usb_stub_reset(void){
+    USB_DEVICE_CDC_EVENT_DATA_READ_COMPLETE read = { 0, 0, USB_DEVICE_CDC_RESULT_ERROR };
+    USB_DEVICE_CDC_EVENT_DATA_WRITE_COMPLETE write = { 0, 0, USB_DEVICE_CDC_RESULT_ERROR };
+    stub_cancelling = true;
+    while(stub_reads.head != stub_reads.tail){
+        read.handle = stub_reads.tail++;
+        stub_handler(USB_DEVICE_CDC_INDEX_0, USB_DEVICE_CDC_EVENT_READ_COMPLETE, &read, stub_user_data);
+    }
+    while(stub_writes != 0){
+        stub_writes--;
+        stub_handler(USB_DEVICE_CDC_INDEX_0, USB_DEVICE_CDC_EVENT_WRITE_COMPLETE, &write, stub_user_data);
+    }
+    stub_cancelling = false;
+    APP_USBDeviceEventHandler(USB_DEVICE_EVENT_RESET, NULL, 0);
+}
+
+size_t usb_stub_cancel_violations(void){
+    return stub_violations;
+}
+
+bool usb_stub_receive(const void *data, size_t length){
+    USB_DEVICE_CDC_EVENT_DATA_READ_COMPLETE read = { stub_reads.tail, length, USB_DEVICE_CDC_RESULT_OK };
+    if(stub_reads.head == stub_reads.tail){
+        return false;
+    }
+    uint8_t slot = stub_reads.tail++ % USB_STUB_QUEUE;
+    if(length > stub_reads.size[slot]){
+        read.length = length = stub_reads.size[slot];
+    }
+    memcpy(stub_reads.data[slot], data, length);
+    stub_handler(USB_DEVICE_CDC_INDEX_0, USB_DEVICE_CDC_EVENT_READ_COMPLETE, &read, stub_user_data);
+    return true;
+}
+
+size_t usb_stub_reads_posted(void){
+    return (uint8_t)(stub_reads.head - stub_reads.tail);
+}
+
+void usb_stub_complete_writes(void){
+    // A completion may submit the next write, which is completed too
+    USB_DEVICE_CDC_EVENT_DATA_WRITE_COMPLETE write = { 0, 0, USB_DEVICE_CDC_RESULT_OK };
+    while(stub_writes != 0){
+        stub_writes--;
+        stub_handler(USB_DEVICE_CDC_INDEX_0, USB_DEVICE_CDC_EVENT_WRITE_COMPLETE, &write, stub_user_data);
+    }
+}
+
+void usb_stub_sof(void){
+    APP_USBDeviceEventHandler(USB_DEVICE_EVENT_SOF, NULL, 0);
+}
+
+const uint8_t* usb_stub_output(size_t *length){
+    *length = stub_output_length;
+    return stub_output;
+}
+
+void usb_stub_output_clear(void){
+    stub_output_length = 0;
+}
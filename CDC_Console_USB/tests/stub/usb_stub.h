@@ -0,0 +1,70 @@
+/**
+ * @file usb_stub.h
+ * @brief Host-side control of the stub USB device layer
+ *
+ * Plays the part of the USB host and the Harmony driver for the tests:
+ * configures the device, completes the posted reads with data and the
+ * writes in flight, and keeps what the device sent.
+ *
+ * @author Alejandro Beltran
+ * @date October 2026
+ */
+
+#ifndef _USB_STUB_H
+#define _USB_STUB_H
+
+#include "definitions.h"
+
+/**
+ * @brief Drops the posted reads and the writes in flight and configures the
+ *        device, as a host opening the port does
+ */
+void usb_stub_configure(void);
+
+/**
+ * @brief Resets the bus the way Harmony does
+ *
+ * Fails every posted read and every write in flight, oldest first, as
+ * USB_DEVICE_IRPCancelAll() does, then raises the RESET event. Reads and
+ * writes submitted while the transfers are being cancelled are counted by
+ * usb_stub_cancel_violations() and not queued.
+ */
+void usb_stub_reset(void);
+
+/**
+ * @brief Number of reads and writes submitted during a usb_stub_reset()
+ */
+size_t usb_stub_cancel_violations(void);
+
+/**
+ * @brief Completes the oldest posted read with data
+ *
+ * @return false if no read is posted, i.e. the device holds all its buffers
+ */
+bool usb_stub_receive(const void *data, size_t length);
+
+/**
+ * @brief Number of reads posted by the device
+ */
+size_t usb_stub_reads_posted(void);
+
+/**
+ * @brief Completes every write in flight, oldest first
+ */
+void usb_stub_complete_writes(void);
+
+/**
+ * @brief Signals the start of a frame
+ */
+void usb_stub_sof(void);
+
+/**
+ * @brief Data written by the device since the last usb_stub_output_clear()
+ *
+ * @param length Receives the number of bytes kept, at most 64 KiB
+ */
+const uint8_t* usb_stub_output(size_t *length);
+
+void usb_stub_output_clear(void);
+
+#endif /* _USB_STUB_H */
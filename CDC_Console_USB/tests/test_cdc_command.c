@@ -0,0 +1,375 @@
+/**
+ * @file test_cdc_command.c
+ * @brief Host tests of the command dispatcher
+ *
+ * The dispatcher is included whole so that its hash and index can be
+ * reached directly: the tests build names that share an index slot or the
+ * whole 32-bit hash, fill the index to its limit and check that every
+ * command is still found by its own name. Dispatching is checked in both
+ * modes through the stub device layer, and the argument parsers over the
+ * edges of the 32-bit range.
+ *
+ * @author Alejandro Beltran
+ * @date October 2026
+ */
+
+#include "../CDC_USB/cdc_command.c"
+#include "stub/usb_stub.h"
+
+#include <stdio.h>
+
+#define CHECK(condition) do { \
+        if(!(condition)){ \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            failures++; \
+        } \
+    } while(0)
+
+#define TEST_GENERATED 4096
+#define TEST_NAME_SIZE 8
+
+static int failures;
+static const cdc_command_t *test_called;
+static int32_t test_value;
+
+static bool test_handler(const cdc_command_args_t *args){
+    test_called = cdc_command_find(args->argv[0]);
+    return true;
+}
+
+/**
+ * @brief Takes one integer from 0 to 9 and responds with it
+ */
+static bool test_digit(const cdc_command_args_t *args){
+    test_called = cdc_command_find(args->argv[0]);
+    if(args->argc != 2 || !cdc_command_arg_int(args, 1, 0, 9, &test_value)){
+        return false;
+    }
+    return cdc_command_respond(args->argv[1]);
+}
+
+// "ad" and "dc" differ by +3 and -1 in characters weighted 1 and 3, so
+// their hashes are equal in all 32 bits
+static const cdc_command_t test_commands[] = {
+    CDC_COMMAND("ad", test_handler, "ad"),
+    CDC_COMMAND("dc", test_handler, "dc"),
+    CDC_COMMAND("digit", test_digit, "digit 0-9"),
+};
+
+static char test_names[TEST_GENERATED][TEST_NAME_SIZE];
+static cdc_command_t test_generated[TEST_GENERATED];
+
+/**
+ * @brief Empties the index
+ */
+static void test_clear(void){
+    memset(command_index_table, 0, sizeof(command_index_table));
+    command_count = 0;
+}
+
+/**
+ * @brief Builds entries named "g0", "g1"... with their runtime hash
+ */
+static void test_generate(void){
+    for(uint16_t i = 0; i < TEST_GENERATED; i++){
+        snprintf(test_names[i], TEST_NAME_SIZE, "g%u", i);
+        test_generated[i] = (cdc_command_t){
+            test_names[i], cdc_command_hash(test_names[i], strlen(test_names[i])), test_handler, "g",
+        };
+    }
+}
+
+/**
+ * @brief Sends a line and returns what the device wrote in response
+ */
+static const char* test_line(const char *line){
+    static char text[256];
+    size_t length;
+    char copy[APP_READ_BUFFER_SIZE];
+    usb_stub_output_clear();
+    strcpy(copy, line);
+    cdc_command_dispatch(copy);
+    cdc_usb_flush();
+    usb_stub_complete_writes();
+    const uint8_t *output = usb_stub_output(&length);
+    length = (length < sizeof(text) - 1) ? length : sizeof(text) - 1;
+    memcpy(text, output, length);
+    text[length] = '\0';
+    return text;
+}
+
+static void test_hash(void){
+    CHECK(CDC_COMMAND_HASH("ad") == CDC_COMMAND_HASH("dc"));
+    CHECK(CDC_COMMAND_HASH("digit") == cdc_command_hash("digit", 5));
+    CHECK(CDC_COMMAND_HASH("0123456789abcdef") == cdc_command_hash("0123456789abcdef", 16));
+}
+
+static void test_register(void){
+    cdc_command_t entry = CDC_COMMAND("bad", test_handler, "bad");
+    test_clear();
+    CHECK(cdc_command_register(test_commands, sizeof(test_commands) / sizeof(test_commands[0])));
+    CHECK(command_count == 3);
+
+    // Same name twice, a forged hash, no handler, a name too long
+    CHECK(!cdc_command_register(&test_commands[2], 1));
+    entry.hash++;
+    CHECK(!cdc_command_register(&entry, 1));
+    entry = (cdc_command_t)CDC_COMMAND("bad", NULL, "bad");
+    CHECK(!cdc_command_register(&entry, 1));
+    entry = (cdc_command_t){ "name_of_17_chars_", 0, test_handler, NULL };
+    entry.hash = cdc_command_hash(entry.name, strlen(entry.name));
+    CHECK(!cdc_command_register(&entry, 1));
+    CHECK(!cdc_command_register(NULL, 1));
+    CHECK(command_count == 3);
+}
+
+static void test_collisions(void){
+    test_clear();
+    CHECK(cdc_command_register(test_commands, sizeof(test_commands) / sizeof(test_commands[0])));
+
+    // Same 32-bit hash: only the string compare tells them apart
+    CHECK(cdc_command_find("ad") == &test_commands[0]);
+    CHECK(cdc_command_find("dc") == &test_commands[1]);
+    CHECK(cdc_command_find("da") == NULL);
+
+    // Names sharing one slot, taken from the most crowded slot so that the
+    // probe sequence runs over several occupied slots
+    uint16_t crowd[CDC_COMMAND_INDEX_SIZE] = { 0 };
+    uint16_t slot = 0;
+    for(uint16_t i = 0; i < TEST_GENERATED; i++){
+        uint16_t at = cdc_command_slot(test_generated[i].hash);
+        if(++crowd[at] > crowd[slot]){
+            slot = at;
+        }
+    }
+    uint16_t same = 0;
+    for(uint16_t i = 0; i < TEST_GENERATED && same < 8; i++){
+        if(cdc_command_slot(test_generated[i].hash) == slot){
+            CHECK(cdc_command_register(&test_generated[i], 1));
+            same++;
+        }
+    }
+    CHECK(same == 8);
+    for(uint16_t i = 0; i < TEST_GENERATED; i++){
+        if(cdc_command_slot(test_generated[i].hash) == slot){
+            CHECK(cdc_command_find(test_names[i]) == (same != 0 ? &test_generated[i] : NULL));
+            same -= (same != 0);
+        }
+    }
+    CHECK(cdc_command_find("ad") == &test_commands[0]);
+}
+
+static void test_full(void){
+    test_clear();
+    for(uint16_t i = 0; i < CDC_COMMAND_INDEX_SIZE - 1; i++){
+        CHECK(cdc_command_register(&test_generated[i], 1));
+    }
+    // One slot stays empty so that a miss ends
+    CHECK(!cdc_command_register(&test_generated[CDC_COMMAND_INDEX_SIZE - 1], 1));
+    for(uint16_t i = 0; i < CDC_COMMAND_INDEX_SIZE - 1; i++){
+        CHECK(cdc_command_find(test_names[i]) == &test_generated[i]);
+    }
+    CHECK(cdc_command_find(test_names[CDC_COMMAND_INDEX_SIZE - 1]) == NULL);
+    CHECK(cdc_command_find("nothing") == NULL);
+}
+
+static void test_dispatch(void){
+    char line[64];
+    test_clear();
+    CHECK(cdc_command_register(test_commands, sizeof(test_commands) / sizeof(test_commands[0])));
+    usb_stub_configure();
+    usb_stub_complete_writes();
+    cdc_command_set_mode(CDC_COMMAND_MODE_INTERACTIVE);
+
+    test_called = NULL;
+    strcpy(line, " \tdc  ");
+    CHECK(cdc_command_dispatch(line) == CDC_COMMAND_OK);
+    CHECK(test_called == &test_commands[1]);
+    strcpy(line, "  \t ");
+    CHECK(cdc_command_dispatch(line) == CDC_COMMAND_EMPTY);
+    CHECK(cdc_command_dispatch(NULL) == CDC_COMMAND_EMPTY);
+
+    // Unknown names, including one longer than any command
+    CHECK(strcmp(test_line("nope 1"), CDC_COMMAND_UNKNOWN_RESPONSE) == 0);
+    CHECK(strcmp(test_line("ad0"), CDC_COMMAND_UNKNOWN_RESPONSE) == 0);
+    CHECK(strcmp(test_line("a_name_far_too_long_for_any_command"), CDC_COMMAND_UNKNOWN_RESPONSE) == 0);
+
+    CHECK(strcmp(test_line("digit 7"), "\r\n7\r\n") == 0);
+    CHECK(test_value == 7);
+    CHECK(strcmp(test_line("digit 10"), CDC_COMMAND_USAGE_PREFIX "digit 0-9\r\n") == 0);
+    CHECK(strcmp(test_line("digit -1"), CDC_COMMAND_USAGE_PREFIX "digit 0-9\r\n") == 0);
+    CHECK(strcmp(test_line("digit"), CDC_COMMAND_USAGE_PREFIX "digit 0-9\r\n") == 0);
+    CHECK(strcmp(test_line("digit 1 2 3 4 5 6 7 8"), CDC_COMMAND_USAGE_PREFIX "digit 0-9\r\n") == 0);
+    strcpy(line, "digit 1 2 3 4 5 6 7 8");
+    CHECK(cdc_command_dispatch(line) == CDC_COMMAND_USAGE);
+    cdc_usb_flush();
+    usb_stub_complete_writes();
+}
+
+static cdc_command_result_t test_result;
+
+static void test_dispatch_line(char *line){
+    test_result = cdc_command_dispatch(line);
+}
+
+/**
+ * @brief Sends a line through the USB layer, so that it takes a line
+ *        number, and returns the response
+ */
+static const char* test_receive(const char *line){
+    static char text[256];
+    size_t length;
+    usb_stub_output_clear();
+    usb_stub_receive(line, strlen(line));
+    cdc_usb_line_task();
+    cdc_usb_flush();
+    usb_stub_complete_writes();
+    const uint8_t *output = usb_stub_output(&length);
+    length = (length < sizeof(text) - 1) ? length : sizeof(text) - 1;
+    memcpy(text, output, length);
+    text[length] = '\0';
+    return text;
+}
+
+static void test_machine(void){
+    cdc_usb_return_line_callback_register(test_dispatch_line);
+    usb_stub_configure();
+    usb_stub_complete_writes();
+    cdc_command_set_mode(CDC_COMMAND_MODE_MACHINE);
+
+    // Results in order, the data after its own result; a failure does not
+    // stop the following commands and empty commands are left out
+    CHECK(strcmp(test_receive("digit 3;nope;;digit 12; digit 5\r"), "=0 0 3;2;3;0 5\r\n") == 0);
+    CHECK(test_result == CDC_COMMAND_UNKNOWN);
+    CHECK(strcmp(test_receive("dc\r"), "=1 0\r\n") == 0);
+    CHECK(test_result == CDC_COMMAND_OK);
+
+    // A line without commands is not answered but takes its number
+    CHECK(strcmp(test_receive(" ; ;\r"), "") == 0);
+    CHECK(test_result == CDC_COMMAND_EMPTY);
+    CHECK(strcmp(test_receive("digit 1 2 3 4 5 6 7 8\r"), "=3 3\r\n") == 0);
+
+    cdc_command_set_mode(CDC_COMMAND_MODE_INTERACTIVE);
+    CHECK(strcmp(test_line("digit 4"), "\r\n4\r\n") == 0);
+}
+
+static void test_parse_int(void){
+    static const struct {
+        const char *text;
+        bool ok;
+        int32_t value;
+    } cases[] = {
+        { "0", true, 0 },
+        { "+42", true, 42 },
+        { "-42", true, -42 },
+        { "2147483647", true, INT32_MAX },
+        { "-2147483648", true, INT32_MIN },
+        { "0x7FFFFFFF", true, INT32_MAX },
+        { "-0x80000000", true, INT32_MIN },
+        { "0xbeef", true, 0xBEEF },
+        { "2147483648", false, 0 },
+        { "-2147483649", false, 0 },
+        { "0x80000000", false, 0 },
+        { "99999999999999999999", false, 0 },
+        { "0x1FFFFFFFFFFFFFFFF", false, 0 },
+        { "", false, 0 },
+        { "-", false, 0 },
+        { "0x", false, 0 },
+        { "12a", false, 0 },
+        { "0xg", false, 0 },
+        { " 1", false, 0 },
+        { "1.0", false, 0 },
+    };
+    for(size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++){
+        int32_t value = 0x5A5A5A5A;
+        bool ok = cdc_command_parse_int(cases[i].text, &value);
+        if(ok != cases[i].ok || value != (ok ? cases[i].value : 0x5A5A5A5A)){
+            printf("%s:%d: parse_int(\"%s\") gave %d, %ld\n", __FILE__, __LINE__,
+                   cases[i].text, ok, (long)value);
+            failures++;
+        }
+    }
+    CHECK(!cdc_command_parse_int(NULL, &test_value));
+    CHECK(!cdc_command_parse_int("1", NULL));
+}
+
+static void test_parse_fixed(void){
+    static const struct {
+        const char *text;
+        uint8_t decimals;
+        bool ok;
+        int32_t value;
+    } cases[] = {
+        { "1.25", 3, true, 1250 },
+        { "1.2345", 3, true, 1235 },
+        { "-1.2345", 3, true, -1235 },
+        { "1.2344", 3, true, 1234 },
+        { ".5", 1, true, 5 },
+        { "5.", 1, true, 50 },
+        { "-0.05", 1, true, -1 },
+        { "7", 0, true, 7 },
+        { "7.5", 0, true, 8 },
+        { "2147483.647", 3, true, INT32_MAX },
+        { "-2147483.648", 3, true, INT32_MIN },
+        { "2.147483647", 9, true, INT32_MAX },
+        { "2147483.648", 3, false, 0 },
+        { "2147483.6475", 3, false, 0 },
+        { "3", 9, false, 0 },
+        { "99999999999", 0, false, 0 },
+        { "1", 10, false, 0 },
+        { ".", 1, false, 0 },
+        { "", 1, false, 0 },
+        { "-", 1, false, 0 },
+        { "1e3", 1, false, 0 },
+        { "1.2.3", 1, false, 0 },
+    };
+    for(size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++){
+        int32_t value = 0x5A5A5A5A;
+        bool ok = cdc_command_parse_fixed(cases[i].text, cases[i].decimals, &value);
+        if(ok != cases[i].ok || value != (ok ? cases[i].value : 0x5A5A5A5A)){
+            printf("%s:%d: parse_fixed(\"%s\", %u) gave %d, %ld\n", __FILE__, __LINE__,
+                   cases[i].text, cases[i].decimals, ok, (long)value);
+            failures++;
+        }
+    }
+}
+
+static void test_args(void){
+    char min[] = "-5";
+    char max[] = "5";
+    char over[] = "6";
+    char fixed[] = "2.5";
+    cdc_command_args_t args = { 5, { "cmd", min, max, over, fixed } };
+    int32_t value = 99;
+
+    CHECK(cdc_command_arg_int(&args, 1, -5, 5, &value) && value == -5);
+    CHECK(cdc_command_arg_int(&args, 2, -5, 5, &value) && value == 5);
+    value = 99;
+    CHECK(!cdc_command_arg_int(&args, 3, -5, 5, &value) && value == 99);
+    CHECK(!cdc_command_arg_int(&args, 1, -4, 5, &value) && value == 99);
+    CHECK(!cdc_command_arg_int(&args, 4, INT32_MIN, INT32_MAX, &value) && value == 99);
+    CHECK(!cdc_command_arg_int(&args, 5, INT32_MIN, INT32_MAX, &value));
+    CHECK(!cdc_command_arg_int(NULL, 1, INT32_MIN, INT32_MAX, &value));
+
+    CHECK(cdc_command_arg_fixed(&args, 4, 1, 0, 25, &value) && value == 25);
+    value = 99;
+    CHECK(!cdc_command_arg_fixed(&args, 4, 1, 0, 24, &value) && value == 99);
+    CHECK(!cdc_command_arg_fixed(&args, 4, 2, 0, 249, &value) && value == 99);
+    CHECK(cdc_command_arg_fixed(&args, 1, 2, -500, 500, &value) && value == -500);
+    CHECK(!cdc_command_arg_fixed(&args, 5, 2, -500, 500, &value));
+}
+
+int main(void){
+    test_generate();
+    test_hash();
+    test_register();
+    test_collisions();
+    test_full();
+    test_dispatch();
+    test_machine();
+    test_parse_int();
+    test_parse_fixed();
+    test_args();
+    printf("test_cdc_command: %s\n", failures == 0 ? "PASS" : "FAIL");
+    return failures != 0;
+}
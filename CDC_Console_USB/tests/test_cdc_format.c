@@ -0,0 +1,216 @@
+/**
+ * @file test_cdc_format.c
+ * @brief Host tests of the printf-free formatters
+ *
+ * Every formatter is compared byte for byte with snprintf() over edge values
+ * and random ones, for every decimal count and hex width, and with buffers
+ * one byte too small, which must be left untouched. Run with --bench to
+ * compare the time taken with snprintf().
+ *
+ * @author Alejandro Beltran
+ * @date October 2026
+ */
+
+#include "cdc_format.h"
+#include "cdc_usb_platform.h"
+#include "stub/usb_stub.h"
+
+#include <stdlib.h>
+#include <time.h>
+
+#define CHECK(condition) do { \
+        if(!(condition)){ \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            failures++; \
+        } \
+    } while(0)
+
+#define TEST_BUFFER 32
+#define TEST_FILL '#'
+
+static int failures;
+
+static const uint32_t test_edges[] = {
+    0U, 1U, 9U, 10U, 99U, 100U, 999999999U, 1000000000U,
+    0x7FFFFFFFU, 0x80000000U, 0x80000001U, 0xFFFFFFFFU, 0xFFFFFFF6U,
+};
+
+/**
+ * @brief Reference fixed-point text built with snprintf()
+ */
+static int test_fixed_reference(char *text, int32_t value, uint8_t decimals){
+    int64_t magnitude = (value < 0) ? -(int64_t)value : value;
+    int64_t scale = 1;
+    for(uint8_t i = 0; i < decimals; i++){
+        scale *= 10;
+    }
+    if(decimals == 0){
+        return snprintf(text, TEST_BUFFER, "%ld", (long)value);
+    }
+    return snprintf(text, TEST_BUFFER, "%s%lld.%0*lld", (value < 0) ? "-" : "",
+                    (long long)(magnitude / scale), decimals, (long long)(magnitude % scale));
+}
+
+/**
+ * @brief Checks one formatted number against the expected text, then the
+ *        same call with a buffer one byte too small
+ */
+#define TEST_FORMAT(call_with_size, expected_text) do { \
+        char buffer[TEST_BUFFER]; \
+        size_t expected_length = strlen(expected_text); \
+        size_t size = TEST_BUFFER; \
+        memset(buffer, TEST_FILL, sizeof(buffer)); \
+        size_t written = call_with_size; \
+        if(written != expected_length || memcmp(buffer, expected_text, expected_length) != 0 || \
+           buffer[expected_length] != TEST_FILL){ \
+            printf("%s:%d: \"%.*s\" instead of \"%s\"\n", __FILE__, __LINE__, \
+                   (int)written, buffer, expected_text); \
+            failures++; \
+        } \
+        size = expected_length - 1; \
+        memset(buffer, TEST_FILL, sizeof(buffer)); \
+        written = call_with_size; \
+        if(written != 0 || buffer[0] != TEST_FILL){ \
+            printf("%s:%d: \"%s\" written into %zu bytes\n", __FILE__, __LINE__, \
+                   expected_text, size); \
+            failures++; \
+        } \
+    } while(0)
+
+static void test_value(uint32_t value){
+    char expected[TEST_BUFFER];
+    int32_t signed_value = (int32_t)value;
+
+    snprintf(expected, sizeof(expected), "%lu", (unsigned long)value);
+    TEST_FORMAT(cdc_format_uint(buffer, size, value), expected);
+    snprintf(expected, sizeof(expected), "%ld", (long)signed_value);
+    TEST_FORMAT(cdc_format_int(buffer, size, signed_value), expected);
+    for(uint8_t digits = 0; digits <= 8; digits++){
+        snprintf(expected, sizeof(expected), "%0*lX", digits, (unsigned long)value);
+        TEST_FORMAT(cdc_format_hex(buffer, size, value, digits), expected);
+    }
+    for(uint8_t decimals = 0; decimals <= CDC_FORMAT_DECIMALS_MAX; decimals++){
+        test_fixed_reference(expected, signed_value, decimals);
+        TEST_FORMAT(cdc_format_fixed(buffer, size, signed_value, decimals), expected);
+    }
+}
+
+static void test_numbers(void){
+    for(size_t i = 0; i < sizeof(test_edges) / sizeof(test_edges[0]); i++){
+        test_value(test_edges[i]);
+    }
+    for(uint32_t scale = 1; scale <= 1000000000U; scale *= 10){
+        test_value(scale - 1);
+        test_value(scale);
+        test_value(0U - scale);
+        test_value(1U - scale);
+    }
+    for(int i = 0; i < 200000; i++){
+        uint32_t value = ((uint32_t)rand() << 16) ^ (uint32_t)rand() ^ ((uint32_t)rand() << 30);
+        test_value(value >> (rand() % 32));
+    }
+}
+
+static void test_limits(void){
+    char buffer[TEST_BUFFER];
+    // Hex widths are clamped to 8 digits, decimals beyond the maximum fail
+    CHECK(cdc_format_hex(buffer, sizeof(buffer), 0x1FU, 12) == 8);
+    CHECK(memcmp(buffer, "0000001F", 8) == 0);
+    CHECK(cdc_format_fixed(buffer, sizeof(buffer), 1, CDC_FORMAT_DECIMALS_MAX + 1) == 0);
+    CHECK(cdc_format_uint(NULL, sizeof(buffer), 1) == 0);
+    CHECK(cdc_format_int(buffer, 0, 0) == 0);
+    // The longest number fits CDC_FORMAT_NUMBER_MAX exactly
+    CHECK(cdc_format_fixed(buffer, CDC_FORMAT_NUMBER_MAX, INT32_MIN, 1) == CDC_FORMAT_NUMBER_MAX);
+    CHECK(memcmp(buffer, "-214748364.8", CDC_FORMAT_NUMBER_MAX) == 0);
+}
+
+static void test_line(void){
+    char text[12];
+    cdc_format_line_t line;
+    size_t length;
+
+    cdc_format_line_init(&line, text, sizeof(text));
+    CHECK(cdc_format_line_str(&line, "v "));
+    CHECK(cdc_format_line_fixed(&line, -3300, 3));
+    CHECK(cdc_format_line_char(&line, 'V'));
+    CHECK(strcmp(cdc_format_line_text(&line), "v -3.300V") == 0);
+    // An append that does not fit leaves the line as it was
+    CHECK(!cdc_format_line_int(&line, 123));
+    CHECK(line.overflow);
+    CHECK(strcmp(cdc_format_line_text(&line), "v -3.300V") == 0);
+    CHECK(!cdc_format_line_char(&line, 'x'));
+    CHECK(!cdc_format_line_write(&line));
+
+    // A line may use the whole buffer but the terminating NUL
+    cdc_format_line_init(&line, text, sizeof(text));
+    CHECK(cdc_format_line_str(&line, "12345678901"));
+    CHECK(!cdc_format_line_char(&line, 'x'));
+    CHECK(strcmp(cdc_format_line_text(&line), "12345678901") == 0);
+
+    cdc_format_line_init(&line, NULL, 0);
+    CHECK(!cdc_format_line_uint(&line, 1));
+    CHECK(strcmp(cdc_format_line_text(&line), "") == 0);
+
+    usb_stub_configure();
+    usb_stub_complete_writes();
+    usb_stub_output_clear();
+    cdc_format_line_init(&line, text, sizeof(text));
+    cdc_format_line_hex(&line, 0xBEEFU, 8);
+    cdc_format_line_str(&line, "\r\n");
+    CHECK(cdc_format_line_write(&line));
+    cdc_usb_flush();
+    const uint8_t *output = usb_stub_output(&length);
+    CHECK(length == 10 && memcmp(output, "0000BEEF\r\n", 10) == 0);
+}
+
+static double test_seconds(void){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+static void test_bench(void){
+    const int rounds = 5000000;
+    char buffer[TEST_BUFFER];
+    volatile size_t sink = 0;
+
+    double start = test_seconds();
+    for(int i = 0; i < rounds; i++){
+        sink += snprintf(buffer, sizeof(buffer), "%ld", (long)(int32_t)((uint32_t)i * 7919U));
+    }
+    double reference = test_seconds() - start;
+    start = test_seconds();
+    for(int i = 0; i < rounds; i++){
+        sink += cdc_format_int(buffer, sizeof(buffer), (int32_t)((uint32_t)i * 7919U));
+    }
+    double formatted = test_seconds() - start;
+    printf("int: snprintf %.0f ns, cdc_format_int %.0f ns\n",
+           reference / rounds * 1e9, formatted / rounds * 1e9);
+
+    start = test_seconds();
+    for(int i = 0; i < rounds; i++){
+        int32_t value = (int32_t)((uint32_t)i * 7919U);
+        sink += test_fixed_reference(buffer, value, 3);
+    }
+    reference = test_seconds() - start;
+    start = test_seconds();
+    for(int i = 0; i < rounds; i++){
+        sink += cdc_format_fixed(buffer, sizeof(buffer), (int32_t)((uint32_t)i * 7919U), 3);
+    }
+    formatted = test_seconds() - start;
+    printf("fixed: snprintf %.0f ns, cdc_format_fixed %.0f ns\n",
+           reference / rounds * 1e9, formatted / rounds * 1e9);
+    (void)sink;
+}
+
+int main(int argc, char **argv){
+    srand(1);
+    test_numbers();
+    test_limits();
+    test_line();
+    if(argc > 1 && strcmp(argv[1], "--bench") == 0){
+        test_bench();
+    }
+    printf("test_cdc_format: %s\n", failures == 0 ? "PASS" : "FAIL");
+    return failures != 0;
+}
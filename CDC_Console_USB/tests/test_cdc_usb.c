@@ -0,0 +1,360 @@
+/**
+ * @file test_cdc_usb.c
+ * @brief Host tests of the CDC line discipline
+ *
+ * The platform layer is included whole so that its static scanner and
+ * parser can be called directly; everything else goes through the USB event
+ * handlers driven by the stub device layer. The random tests compare the
+ * scanner with a byte-by-byte scan and the parser with a reference model of
+ * the line discipline. Run with --bench to time the scanner and the parser.
+ *
+ * @author Alejandro Beltran
+ * @date October 2026
+ */
+
+#include "../CDC_USB/cdc_usb_platform.c"
+#include "stub/usb_stub.h"
+
+#include <stdlib.h>
+#include <time.h>
+
+#define CHECK(condition) do { \
+        if(!(condition)){ \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            failures++; \
+        } \
+    } while(0)
+
+#define TEST_LINES_MAX 4096
+
+static int failures;
+static char received[TEST_LINES_MAX][APP_READ_BUFFER_SIZE];
+static size_t received_count;
+
+static void test_line(char *line){
+    if(received_count < TEST_LINES_MAX){
+        strcpy(received[received_count], line);
+    }
+    received_count++;
+}
+
+static void test_connect(void){
+    usb_stub_configure();
+    usb_stub_complete_writes();
+    usb_stub_output_clear();
+    received_count = 0;
+}
+
+/**
+ * @brief Sends data the way a host does, waiting while the device holds
+ *        every read buffer
+ */
+static void test_send(const void *data, size_t length){
+    while(!usb_stub_receive(data, length)){
+        cdc_usb_line_task();
+    }
+    usb_stub_sof();
+    usb_stub_complete_writes();
+}
+
+/**
+ * @brief Runs the main loop until no more lines come
+ */
+static void test_poll(void){
+    size_t count;
+    do {
+        count = received_count;
+        cdc_usb_line_task();
+    } while(received_count != count);
+}
+
+static uint16_t test_scan_reference(const uint8_t *data, uint16_t length){
+    uint16_t i = 0;
+    while(i < length && data[i] >= 0x20 && data[i] != 0x7F){
+        i++;
+    }
+    return i;
+}
+
+static void test_scan(void){
+    static uint8_t buffer[64 + 8] __attribute__((aligned(4)));
+    for(int t = 0; t < 1000000; t++){
+        uint16_t length = rand() % 64;
+        uint16_t offset = rand() % 8;
+        for(uint16_t i = 0; i < length; i++){
+            int r = rand() % 100;
+            buffer[offset + i] = r < 3 ? '\r' : r < 5 ? (uint8_t)(rand() % 32) : r < 6 ? 0x7F :
+                                 r < 7 ? (uint8_t)(0x80 + rand() % 128) : (uint8_t)(0x20 + rand() % 95);
+        }
+        if(cdc_usb_scan(&buffer[offset], length) != test_scan_reference(&buffer[offset], length)){
+            CHECK(!"scan differs from the byte-by-byte scan");
+            return;
+        }
+    }
+}
+
+static void test_lines_in_one_packet(void){
+    test_connect();
+    test_send("a\rb\r", 4);
+    CHECK(received_count == 0);         // Lines are delivered by the main loop
+    cdc_usb_line_task();
+    CHECK(received_count == 2);
+    CHECK(strcmp(received[0], "a") == 0);
+    CHECK(strcmp(received[1], "b") == 0);
+}
+
+static void test_queue_full(void){
+    char packet[APP_READ_BUFFER_SIZE];
+    size_t length = 0;
+    test_connect();
+    for(int i = 0; i < 10; i++){
+        length += sprintf(&packet[length], "line %d\r", i);
+    }
+    CHECK(usb_stub_receive(packet, length));
+    // The parser stops at the fifth terminator and holds its buffer
+    CHECK(usb_stub_reads_posted() == CDC_USB_RX_IRPS - 1);
+    for(int i = 0; i < CDC_USB_RX_IRPS - 1; i++){
+        CHECK(usb_stub_receive(packet, length));
+    }
+    CHECK(!usb_stub_receive(packet, length));
+    test_poll();
+    CHECK(usb_stub_reads_posted() == CDC_USB_RX_IRPS);
+    CHECK(received_count == 10 * CDC_USB_RX_IRPS);
+    for(size_t i = 0; i < received_count && i < 10 * CDC_USB_RX_IRPS; i++){
+        char expected[16];
+        sprintf(expected, "line %d", (int)(i % 10));
+        CHECK(strcmp(received[i], expected) == 0);
+    }
+}
+
+static void test_reconnect(void){
+    test_connect();
+    test_send("stale\r", 6);
+    test_connect();
+    cdc_usb_line_task();
+    CHECK(received_count == 0);
+    CHECK(cdc_usb_line_number() == 0xFFFF);
+    test_send("fresh\r", 6);
+    cdc_usb_line_task();
+    CHECK(received_count == 1);
+    CHECK(strcmp(received[0], "fresh") == 0);
+}
+
+static bool test_contains(const uint8_t *data, size_t length, const char *text){
+    size_t size = strlen(text);
+    for(size_t i = 0; i + size <= length; i++){
+        if(memcmp(&data[i], text, size) == 0){
+            return true;
+        }
+    }
+    return false;
+}
+
+static void test_overflow(void){
+    char packet[APP_READ_BUFFER_SIZE];
+    uint32_t overflows = usbState.rxOverflows;
+    size_t length;
+    test_connect();
+    memset(packet, 'x', sizeof(packet));
+    test_send(packet, sizeof(packet));
+    test_send("y\rok\r", 5);
+    test_poll();
+    CHECK(usbState.rxOverflows == overflows + 1);
+    CHECK(received_count == 1);
+    CHECK(strcmp(received[0], "ok") == 0);
+    CHECK(cdc_usb_line_number() == 1);  // The discarded line took number 0
+    const uint8_t *output = usb_stub_output(&length);
+    CHECK(test_contains(output, length, CDC_USB_LINE_OVERFLOW_RESPONSE));
+}
+
+static int test_done_calls;
+
+static void test_done(void *context){
+    (void)context;
+    test_done_calls++;
+}
+
+/**
+ * @brief A reconnect while a producer is copying drops the queued records
+ *        once it finishes, releasing reference buffers
+ */
+static void test_reset_during_write(void){
+    static const char old_data[] = "old";
+    uint16_t position;
+    size_t length;
+
+    test_connect();
+    cdc_usb_set_coalescing(true);
+    test_done_calls = 0;
+    CHECK(cdc_usb_write_buffer(old_data, 3, test_done, NULL));
+    // A producer interrupted by the reconnect
+    CHECK(cdc_usb_tx_reserve(CDC_USB_TX_HEADER_SIZE + 3, &position));
+    usb_stub_configure();
+    CHECK(test_done_calls == 0);
+    uint8_t record[CDC_USB_TX_HEADER_SIZE + 3] = { 3, 0, 'o', 'l', 'd' };
+    cdc_usb_tx_put(position, record, sizeof(record));
+    cdc_usb_tx_commit(false);
+    CHECK(test_done_calls == 1);
+
+    usb_stub_complete_writes();
+    usb_stub_output_clear();
+    CHECK(cdc_usb_write_bytes("new", 3));
+    cdc_usb_flush();
+    usb_stub_complete_writes();
+    const uint8_t *output = usb_stub_output(&length);
+    CHECK(length == 3 && memcmp(output, "new", 3) == 0);
+    cdc_usb_set_coalescing(false);
+}
+
+/**
+ * @brief A bus reset cancels the posted reads and the writes in flight
+ *
+ * Nothing may be submitted from the cancelled completions; the reads are
+ * posted again, and the port works again, once the device is configured.
+ */
+static void test_abort_on_reset(void){
+    static const char held[] = "held";
+    size_t violations = usb_stub_cancel_violations();
+    size_t length;
+
+    test_connect();
+    test_send("partial", 7);
+    // One more write than there are transfer slots stays queued
+    test_done_calls = 0;
+    for(int i = 0; i <= CDC_USB_TX_IRPS; i++){
+        CHECK(cdc_usb_write_buffer(held, 4, test_done, NULL));
+    }
+    usb_stub_reset();
+    CHECK(usb_stub_cancel_violations() == violations);
+    CHECK(usb_stub_reads_posted() == 0);
+    CHECK(test_done_calls == CDC_USB_TX_IRPS);
+    CHECK(!cdc_usb_write_bytes("late", 4));
+
+    test_connect();
+    CHECK(test_done_calls == CDC_USB_TX_IRPS + 1);
+    CHECK(usb_stub_reads_posted() == CDC_USB_RX_IRPS);
+    test_send("next\r", 5);
+    test_poll();
+    CHECK(received_count == 1 && strcmp(received[0], "next") == 0);
+    const uint8_t *output = usb_stub_output(&length);
+    CHECK(length == 4 && memcmp(output, "next", 4) == 0);
+}
+
+/**
+ * @brief Random input against a reference model of the line discipline
+ */
+static void test_parse_random(void){
+    static char expected[APP_READ_BUFFER_SIZE][APP_READ_BUFFER_SIZE];
+    char line[APP_READ_BUFFER_SIZE];
+    uint8_t packet[APP_READ_BUFFER_SIZE];
+    size_t length = 0;
+    bool overflow = false;
+    uint32_t overflows = usbState.rxOverflows;
+    uint32_t expected_overflows = 0;
+
+    test_connect();
+    for(int t = 0; t < 200000 && failures == 0; t++){
+        uint16_t size = (rand() % 16 == 0) ? 1 + rand() % APP_READ_BUFFER_SIZE : 1 + rand() % 64;
+        size_t lines = 0;
+        for(uint16_t i = 0; i < size; i++){
+            int r = rand() % 200;
+            packet[i] = r < 3 ? '\r' : r < 4 ? 8 : r < 5 ? 7 : r < 6 ? '\n' : r < 7 ? 0x7F :
+                        r < 8 ? (uint8_t)(rand() % 32) : (uint8_t)(0x20 + rand() % 95);
+            uint8_t c = packet[i];
+            if(c == '\r'){
+                if(overflow){
+                    expected_overflows++;
+                } else {
+                    line[length] = '\0';
+                    strcpy(expected[lines++], line);
+                }
+                length = 0;
+                overflow = false;
+            } else if(c == '\n' || c == '\0'){
+            } else if(c == 7 || c == 21){
+                length = 0;
+                overflow = false;
+            } else if(c == 8 || c == 0x7F){
+                if(length > 0 && !overflow){
+                    length--;
+                }
+            } else if(length < APP_READ_BUFFER_SIZE - 1){
+                line[length++] = (char)c;
+            } else {
+                overflow = true;
+            }
+        }
+
+        received_count = 0;
+        cdc_usb_set_echo(rand() % 2);
+        test_send(packet, size);
+        test_poll();
+        CHECK(received_count == lines);
+        for(size_t i = 0; i < lines && i < received_count; i++){
+            CHECK(strcmp(received[i], expected[i]) == 0);
+        }
+        CHECK(command_index == length);
+    }
+    CHECK(usbState.rxOverflows - overflows == expected_overflows);
+}
+
+static double test_seconds(void){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+static void test_bench(void){
+    static uint8_t buffer[APP_READ_BUFFER_SIZE] __attribute__((aligned(4)));
+    const int rounds = 200000;
+    volatile uint32_t sink = 0;
+    for(size_t i = 0; i < sizeof(buffer); i++){
+        buffer[i] = (i % 40 == 39) ? '\r' : (uint8_t)('a' + i % 26);
+    }
+
+    double start = test_seconds();
+    for(int r = 0; r < rounds; r++){
+        sink += test_scan_reference(buffer, 39);
+    }
+    double bytewise = test_seconds() - start;
+    start = test_seconds();
+    for(int r = 0; r < rounds; r++){
+        sink += cdc_usb_scan(buffer, 39);
+    }
+    double wordwise = test_seconds() - start;
+    printf("scan: byte by byte %.0f MB/s, word at a time %.0f MB/s\n",
+           rounds * 39 / bytewise / 1e6, rounds * 39 / wordwise / 1e6);
+
+    test_connect();
+    cdc_usb_set_echo(false);
+    cdc_usb_return_line_callback_unregister();
+    start = test_seconds();
+    for(int r = 0; r < rounds; r++){
+        uint16_t offset = 0;
+        while(offset < sizeof(buffer)){
+            offset += cdc_usb_parse(&buffer[offset], sizeof(buffer) - offset);
+            cdc_usb_line_task();
+        }
+    }
+    double parse = test_seconds() - start;
+    printf("parse: %.0f MB/s, 40-byte lines\n", rounds * sizeof(buffer) / parse / 1e6);
+    (void)sink;
+}
+
+int main(int argc, char **argv){
+    srand(1);
+    cdc_usb_return_line_callback_register(test_line);
+    test_scan();
+    test_lines_in_one_packet();
+    test_queue_full();
+    test_reconnect();
+    test_overflow();
+    test_reset_during_write();
+    test_abort_on_reset();
+    test_parse_random();
+    if(argc > 1 && strcmp(argv[1], "--bench") == 0){
+        test_bench();
+    }
+    printf("test_cdc_usb: %s\n", failures == 0 ? "PASS" : "FAIL");
+    return failures != 0;
+}
@@ -0,0 +1,235 @@
+#!/usr/bin/env python3
+"""Decode the deferred log records of the CDC console.
+
+The format strings are read from the .cdc_log section of the firmware ELF
+file, the records from the CDC stream: a capture file, standard input or a
+serial port (--port, needs pyserial). The firmware only sends the log in
+machine mode, so --port switches the console to it after opening the port.
+Console text and the frames of the other channels are skipped unless
+--text is given.
+
+    cdc_log_decode.py --elf CDC_Console_USB.X.production.elf --port COM5
+    cdc_log_decode.py --elf firmware.elf capture.bin
+    cdc_log_decode.py --elf firmware.elf --dump
+
+@author Alejandro Beltran
+@date October 2026
+"""
+
+import argparse
+import binascii
+import re
+import struct
+import sys
+
+LOG_SECTION = ".cdc_log"
+LOG_CHANNEL = 2
+ID_DROPPED = 0xFFFF
+VALID = 1 << 31
+EPOCH_SPAN = 2048 << 32     # The record time wraps after 2048 epochs
+
+CONVERSION = re.compile(r"%([-+ #0]*\d*(?:\.\d+)?)(?:hh|h|ll|l|j|z|t)?([diuxXoc%])")
+
+
+def read_strings(path):
+    """Return {format id: format string} from the log section of an ELF file."""
+    with open(path, "rb") as file:
+        elf = file.read()
+    if elf[:4] != b"\x7fELF":
+        raise ValueError(f"{path} is not an ELF file")
+    is64 = elf[4] == 2
+    order = "<" if elf[5] == 1 else ">"
+    if is64:
+        shoff, = struct.unpack_from(order + "Q", elf, 0x28)
+        shentsize, shnum, shstrndx = struct.unpack_from(order + "HHH", elf, 0x3A)
+        header = order + "IIQQQQIIQQ"
+    else:
+        shoff, = struct.unpack_from(order + "I", elf, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from(order + "HHH", elf, 0x2E)
+        header = order + "IIIIIIIIII"
+    sections = [struct.unpack_from(header, elf, shoff + i * shentsize) for i in range(shnum)]
+    names_offset = sections[shstrndx][4]
+
+    strings = {}
+    for name, _, _, address, offset, size, *_ in sections:
+        end = elf.index(b"\0", names_offset + name)
+        if elf[names_offset + name:end].decode() != LOG_SECTION:
+            continue
+        data = elf[offset:offset + size]
+        start = 0
+        while start < len(data):
+            stop = data.find(b"\0", start)
+            stop = len(data) if stop < 0 else stop
+            if stop > start:
+                # The records carry the low 16 bits of the string address
+                strings[(address + start) & 0xFFFF] = data[start:stop].decode("utf-8", "replace")
+            start = stop + 1
+    return strings
+
+
+def format_record(strings, identifier, args):
+    if identifier == ID_DROPPED:
+        return f"<{args[0]} records dropped>"
+    text = strings.get(identifier)
+    if text is None:
+        return f"<unknown format 0x{identifier:04X}> " + " ".join(f"0x{a:08X}" for a in args)
+
+    out = []
+    position = 0
+    used = 0
+    for match in CONVERSION.finditer(text):
+        out.append(text[position:match.start()])
+        position = match.end()
+        flags, kind = match.groups()
+        if kind == "%":
+            out.append("%")
+            continue
+        word = args[used] if used < len(args) else 0
+        used += 1
+        if kind in "di":
+            word -= (word & 0x80000000) << 1
+        out.append(("%" + flags + ("d" if kind in "diu" else kind)) % word)
+    out.append(text[position:])
+    return "".join(out)
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0:
+            return None
+        out += data[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+class Decoder:
+    """Splits the CDC stream into text and frames and decodes the log frames.
+
+    Frames are enclosed in zero bytes and text never contains one, so every
+    run of bytes between two zeros is a candidate frame: it is taken as a
+    frame when it decodes and its CRC matches, and as text otherwise. The
+    decoder therefore needs no state to tell frames from text, and finds the
+    next frame by itself when the capture starts in the middle of one.
+    """
+
+    def __init__(self, strings, clock, show_text):
+        self.strings = strings
+        self.clock = clock
+        self.show_text = show_text
+        self.pending = bytearray()
+        self.shown = 0
+        self.sequence = None
+        self.start = None
+        self.base = 0
+        self.last = 0
+
+    def feed(self, data):
+        start = 0
+        while (end := data.find(b"\0", start)) >= 0:
+            self.pending += data[start:end]
+            if not self.frame(bytes(self.pending)):
+                self.text(self.pending[self.shown:])
+            self.pending.clear()
+            self.shown = 0
+            start = end + 1
+        self.pending += data[start:]
+        sys.stdout.flush()
+
+    def idle(self):
+        """Show the text received so far while the stream is quiet.
+
+        A frame is sent in one piece, so a run still open when the stream
+        pauses is almost always text; it is only shown, and is still tried
+        as a frame when its closing zero arrives.
+        """
+        self.text(self.pending[self.shown:])
+        self.shown = len(self.pending)
+        sys.stdout.flush()
+
+    def text(self, data):
+        if self.show_text and data:
+            sys.stdout.write(data.decode("latin-1"))
+
+    def frame(self, encoded):
+        """Decode a candidate frame, returning False if it is not one."""
+        raw = cobs_decode(encoded)
+        if raw is None or len(raw) < 4:
+            return False
+        body, crc = raw[:-2], int.from_bytes(raw[-2:], "little")
+        if binascii.crc_hqx(body, 0xFFFF) != crc:
+            return False
+        channel, sequence, payload = body[0], body[1], body[2:]
+        if channel != LOG_CHANNEL:
+            return True
+        if self.sequence is not None and sequence != (self.sequence + 1) & 0xFF:
+            print("<log frames lost>")
+        self.sequence = sequence
+        words = struct.unpack_from(f"<{len(payload) // 4}I", payload)
+        i = 0
+        while i + 2 <= len(words):
+            header, cycles = words[i], words[i + 1]
+            count = (header >> 16) & 0x0F
+            if not header & VALID or i + 2 + count > len(words):
+                print("<malformed log frame>")
+                return True
+            args = words[i + 2:i + 2 + count]
+            i += 2 + count
+            print(f"[{self.seconds(header, cycles):12.6f}] {format_record(self.strings, header & 0xFFFF, args)}")
+        return True
+
+    def seconds(self, header, cycles):
+        """Time of a record from the epoch and the cycle counter."""
+        time = (((header >> 20) & 0x7FF) << 32 | cycles) + self.base
+        # Interrupt records may come slightly out of order; a step back of
+        # more than half the span is the epoch wrapping
+        if time < self.last - EPOCH_SPAN // 2:
+            self.base += EPOCH_SPAN
+            time += EPOCH_SPAN
+        self.last = max(self.last, time)
+        if self.start is None:
+            self.start = time
+        return (time - self.start) / self.clock
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--elf", required=True, help="firmware ELF file holding the format strings")
+    parser.add_argument("--port", help="serial port to read from (needs pyserial)")
+    parser.add_argument("--clock", type=float, default=120e6, help="CPU clock in Hz (default 120e6)")
+    parser.add_argument("--text", action="store_true", help="also print the console text")
+    parser.add_argument("--dump", action="store_true", help="print the string table and exit")
+    parser.add_argument("capture", nargs="?", help="capture file (default: standard input)")
+    options = parser.parse_args()
+
+    strings = read_strings(options.elf)
+    if options.dump:
+        for identifier in sorted(strings):
+            print(f"0x{identifier:04X} {strings[identifier]!r}")
+        return
+
+    decoder = Decoder(strings, options.clock, options.text)
+    if options.port:
+        import serial
+        with serial.Serial(options.port, timeout=0.1) as port:
+            port.dtr = True
+            port.write(b"mode machine\r")
+            while True:
+                data = port.read(4096)
+                if data:
+                    decoder.feed(data)
+                else:
+                    decoder.idle()
+    else:
+        source = open(options.capture, "rb") if options.capture else sys.stdin.buffer
+        with source:
+            while chunk := source.read(4096):
+                decoder.feed(chunk)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,205 @@
+/**
+ * @file closed_loop_api.c
+ * @brief Implementation of the fixed-point closed-loop controller
+ *
+ * @author Alejandro Beltran
+ * @date October 2026
+ */
+
+#include "closed_loop_api.h"
+#include "closed_loop_platform.h"
+
+#include "ads8866_api.h"
+#include "mcp48fvxx_api.h"
+
+#include <string.h>
+
+/**
+ * @brief Controller state
+ *
+ * Output limits and the integrator are kept in Q16.16 so the iteration
+ * only needs multiplies, adds and compares.
+ */
+static struct {
+    int32_t kp;
+    int32_t ki;
+    int32_t kd;
+    volatile uint16_t setpoint;
+    int64_t output_min;         // Q16.16
+    int64_t output_max;         // Q16.16
+    int64_t integral;           // Q16.16
+    int32_t prev_measurement;
+    uint32_t frame_base;        // DAC frame encoded with value 0
+    uint32_t period_us;
+    uint32_t period_cycles;
+    uint32_t last_start;
+    uint16_t measurement;
+    uint16_t output;
+    bool primed;
+    bool configured;
+    bool running;
+} loop;
+
+static closed_loop_stats_t loop_stats;
+
+bool closed_loop_configure(const closed_loop_config_t *config)
+{
+    if (config == NULL || loop.running)
+    {
+        return false;
+    }
+    if (config->output_min > config->output_max || config->output_max > 4095 ||
+        config->output_initial < config->output_min || config->output_initial > config->output_max ||
+        config->period_us == 0)
+    {
+        return false;
+    }
+    if (!mcp48fvxx_output_frame(config->dac_channel, 0, &loop.frame_base))
+    {
+        return false; // Invalid channel
+    }
+
+    loop.kp = config->kp;
+    loop.ki = config->ki;
+    loop.kd = config->kd;
+    loop.setpoint = config->setpoint;
+    loop.output_min = (int64_t)config->output_min << CLOSED_LOOP_GAIN_SHIFT;
+    loop.output_max = (int64_t)config->output_max << CLOSED_LOOP_GAIN_SHIFT;
+    loop.integral = (int64_t)config->output_initial << CLOSED_LOOP_GAIN_SHIFT;
+    loop.output = config->output_initial;
+    loop.period_us = config->period_us;
+    loop.period_cycles = config->period_us * closed_loop_platform_cycles_per_us();
+    loop.primed = false;
+    loop.configured = true;
+    closed_loop_reset_stats();
+    return true;
+}
+
+bool closed_loop_start(void)
+{
+    if (!loop.configured || loop.running)
+    {
+        return false;
+    }
+    loop.primed = false;
+    loop.running = true;
+    if (!closed_loop_platform_timer_start(loop.period_us))
+    {
+        loop.running = false;
+        return false;
+    }
+    return true;
+}
+
+void closed_loop_stop(void)
+{
+    closed_loop_platform_timer_stop();
+    loop.running = false;
+}
+
+void closed_loop_set_setpoint(uint16_t setpoint)
+{
+    loop.setpoint = setpoint;
+}
+
+void closed_loop_step(void)
+{
+    uint32_t start = closed_loop_platform_cycles();
+    if (loop.primed)
+    {
+        uint32_t interval = start - loop.last_start;
+        if (interval > loop_stats.max_interval)
+        {
+            loop_stats.max_interval = interval;
+        }
+    }
+    loop.last_start = start;
+
+    int32_t measurement = ads8866_read_raw();
+    if (!loop.primed)
+    {
+        loop.prev_measurement = measurement; // No derivative kick on the first iteration
+        loop.primed = true;
+    }
+
+    int32_t error = (int32_t)loop.setpoint - measurement;
+    int64_t integral = loop.integral + (int64_t)loop.ki * error;
+    int64_t output = (int64_t)loop.kp * error + integral
+                   + (int64_t)loop.kd * (loop.prev_measurement - measurement);
+    loop.prev_measurement = measurement;
+
+    // Clamp the output and stop integrating further into saturation (anti-windup)
+    if (output > loop.output_max)
+    {
+        output = loop.output_max;
+        loop_stats.saturations++;
+        if (integral > loop.integral)
+        {
+            integral = loop.integral;
+        }
+    }
+    else if (output < loop.output_min)
+    {
+        output = loop.output_min;
+        loop_stats.saturations++;
+        if (integral < loop.integral)
+        {
+            integral = loop.integral;
+        }
+    }
+    if (integral > loop.output_max)
+    {
+        integral = loop.output_max;
+    }
+    else if (integral < loop.output_min)
+    {
+        integral = loop.output_min;
+    }
+    loop.integral = integral;
+
+    uint16_t code = (uint16_t)(output >> CLOSED_LOOP_GAIN_SHIFT);
+    if (!mcp48fvxx_write_frame(loop.frame_base | code))
+    {
+        loop_stats.dac_errors++;
+    }
+    loop.measurement = (uint16_t)measurement;
+    loop.output = code;
+
+    uint32_t elapsed = closed_loop_platform_cycles() - start;
+    loop_stats.iterations++;
+    loop_stats.last_cycles = elapsed;
+    loop_stats.total_cycles += elapsed;
+    if (elapsed > loop_stats.max_cycles)
+    {
+        loop_stats.max_cycles = elapsed;
+    }
+    if (elapsed < loop_stats.min_cycles)
+    {
+        loop_stats.min_cycles = elapsed;
+    }
+    if (elapsed > loop.period_cycles)
+    {
+        loop_stats.overruns++;
+    }
+}
+
+uint16_t closed_loop_get_measurement(void)
+{
+    return loop.measurement;
+}
+
+uint16_t closed_loop_get_output(void)
+{
+    return loop.output;
+}
+
+const closed_loop_stats_t* closed_loop_get_stats(void)
+{
+    return &loop_stats;
+}
+
+void closed_loop_reset_stats(void)
+{
+    memset(&loop_stats, 0, sizeof(loop_stats));
+    loop_stats.min_cycles = UINT32_MAX;
+}
\ No newline at end of file
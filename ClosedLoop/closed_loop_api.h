@@ -0,0 +1,137 @@
+/**
+ * @file closed_loop_api.h
+ * @brief Fixed-point closed-loop controller from ADS8866 input to MCP48FVXX output
+ *
+ * This module runs a PID loop at a fixed period driven by a platform timer.
+ * Each iteration reads a raw ADS8866 code, computes the PID output in
+ * Q16.16 fixed point, clamps it and writes a pre-encoded MCP48FVXX frame.
+ * No floating point math, argument validation or command encoding is done
+ * inside the loop, so it can run at tens of kHz.
+ *
+ * @author Alejandro Beltran
+ * @date October 2026
+ */
+
+#ifndef CLOSED_LOOP_API_H
+#define CLOSED_LOOP_API_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Number of fractional bits of the PID gains */
+#define CLOSED_LOOP_GAIN_SHIFT  16
+/** @brief Convert a real gain to Q16.16 at compile time (e.g. CLOSED_LOOP_GAIN(0.25)) */
+#define CLOSED_LOOP_GAIN(x)     ((int32_t)((x) * (1L << CLOSED_LOOP_GAIN_SHIFT)))
+
+/**
+ * @brief Controller configuration
+ *
+ * Gains are expressed in DAC codes per ADC code, in Q16.16 fixed point.
+ * The integral gain is applied once per iteration, so it already includes
+ * the loop period. Use negative gains for an inverting plant.
+ */
+typedef struct {
+    int32_t kp;                 /**< Proportional gain (Q16.16) */
+    int32_t ki;                 /**< Integral gain per iteration (Q16.16) */
+    int32_t kd;                 /**< Derivative gain per iteration (Q16.16), applied to the measurement */
+    uint16_t setpoint;          /**< Target ADS8866 code (0-65535) */
+    uint16_t output_min;        /**< Lowest DAC code the loop may write */
+    uint16_t output_max;        /**< Highest DAC code the loop may write (0-4095) */
+    uint16_t output_initial;    /**< DAC code used to preset the integrator for a bumpless start */
+    uint8_t dac_channel;        /**< MCP48FVXX channel driven by the loop */
+    uint32_t period_us;         /**< Loop period in microseconds */
+} closed_loop_config_t;
+
+/**
+ * @brief Per-iteration timing and error statistics
+ *
+ * Cycle values are in ticks of closed_loop_platform_cycles(). The fields are
+ * updated from the timer interrupt; read them with the loop stopped or accept
+ * that a snapshot may mix two iterations.
+ */
+typedef struct {
+    uint32_t iterations;        /**< Iterations executed since the last reset */
+    uint32_t last_cycles;       /**< Duration of the most recent iteration */
+    uint32_t min_cycles;        /**< Shortest iteration */
+    uint32_t max_cycles;        /**< Longest iteration (worst-case loop time) */
+    uint64_t total_cycles;      /**< Sum of all iteration durations, for the average */
+    uint32_t max_interval;      /**< Longest time between the start of two iterations */
+    uint32_t overruns;          /**< Iterations longer than the loop period */
+    uint32_t saturations;       /**< Iterations where the output was clamped */
+    uint32_t dac_errors;        /**< DAC writes rejected by the device */
+} closed_loop_stats_t;
+
+/**
+ * @brief Configure the controller
+ *
+ * Validates the configuration, pre-encodes the DAC frame and resets the
+ * controller state. The loop must be stopped.
+ *
+ * @param config Controller configuration
+ * @return bool true if the configuration is valid, false otherwise
+ */
+bool closed_loop_configure(const closed_loop_config_t *config);
+
+/**
+ * @brief Start the loop timer
+ *
+ * @return bool true if the loop was started, false if it is not configured or the timer failed
+ */
+bool closed_loop_start(void);
+
+/**
+ * @brief Stop the loop timer
+ *
+ * The DAC keeps the last written value.
+ */
+void closed_loop_stop(void);
+
+/**
+ * @brief Change the setpoint while the loop is running
+ *
+ * @param setpoint New target ADS8866 code
+ */
+void closed_loop_set_setpoint(uint16_t setpoint);
+
+/**
+ * @brief Execute one loop iteration
+ *
+ * Called from the platform timer interrupt handler once per period.
+ */
+void closed_loop_step(void);
+
+/**
+ * @brief Get the last measured ADC code
+ *
+ * @return uint16_t Raw ADS8866 code read by the most recent iteration
+ */
+uint16_t closed_loop_get_measurement(void);
+
+/**
+ * @brief Get the last DAC code written by the loop
+ *
+ * @return uint16_t DAC code written by the most recent iteration
+ */
+uint16_t closed_loop_get_output(void);
+
+/**
+ * @brief Get the loop statistics
+ *
+ * @return const closed_loop_stats_t* Pointer to the live statistics
+ */
+const closed_loop_stats_t* closed_loop_get_stats(void);
+
+/**
+ * @brief Clear the loop statistics
+ */
+void closed_loop_reset_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CLOSED_LOOP_API_H */
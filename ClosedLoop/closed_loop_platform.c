@@ -0,0 +1,39 @@
+/**
+ * @file closed_loop_platform.c
+ * @brief Implementation of platform-specific timer functions for the closed-loop controller
+ *
+ * These functions should be implemented according to the specific platform
+ * being used.
+ *
+ * @author Alejandro Beltran
+ * @date October 2026
+ */
+
+#include "closed_loop_platform.h"
+#include "closed_loop_api.h"
+
+#include "peripheral/tc/plib_tc0.h"
+
+bool closed_loop_platform_timer_start(uint32_t period_us)
+{
+    // TODO - Configure a periodic timer with the given period and call
+    // closed_loop_step() from its interrupt handler.
+    return false;
+}
+
+void closed_loop_platform_timer_stop(void)
+{
+    // TODO - Stop the periodic timer
+}
+
+uint32_t closed_loop_platform_cycles(void)
+{
+    // TODO - Return a free-running cycle counter (e.g. DWT->CYCCNT)
+    return 0;
+}
+
+uint32_t closed_loop_platform_cycles_per_us(void)
+{
+    // TODO - Return the cycle counter frequency in MHz
+    return 1;
+}
\ No newline at end of file
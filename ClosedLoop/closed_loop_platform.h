@@ -0,0 +1,59 @@
+/**
+ * @file closed_loop_platform.h
+ * @brief Platform-specific timer interface for the closed-loop controller
+ *
+ * This file declares the hardware abstraction layer functions needed to
+ * run the controller at a fixed period and to measure the duration of
+ * each iteration.
+ *
+ * @author Alejandro Beltran
+ * @date October 2026
+ */
+
+#ifndef CLOSED_LOOP_PLATFORM_H
+#define CLOSED_LOOP_PLATFORM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Start the periodic loop timer
+ *
+ * The timer interrupt handler must call closed_loop_step() once per period.
+ *
+ * @param period_us Loop period in microseconds
+ * @return bool true if the timer was started, false if the period is not supported
+ */
+bool closed_loop_platform_timer_start(uint32_t period_us);
+
+/**
+ * @brief Stop the periodic loop timer
+ */
+void closed_loop_platform_timer_stop(void);
+
+/**
+ * @brief Read a free-running cycle counter
+ *
+ * Used only for timing statistics. The counter must count up and wrap
+ * at 2^32 (e.g. DWT->CYCCNT on Cortex-M3/M4/M7).
+ *
+ * @return uint32_t Current counter value
+ */
+uint32_t closed_loop_platform_cycles(void);
+
+/**
+ * @brief Get the frequency of the cycle counter
+ *
+ * @return uint32_t Counter ticks per microsecond
+ */
+uint32_t closed_loop_platform_cycles_per_us(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CLOSED_LOOP_PLATFORM_H */
@@ -0,0 +1,149 @@
+/**
+ * @file driver_status.h
+ * @brief Common status codes and health counters for FirmwareForge drivers
+ *
+ * This header is shared by the device libraries in this repository. It
+ * defines a single status enumeration used to report errors without any
+ * string handling, and a small set of per-device health counters that the
+ * drivers update on every bus transfer.
+ *
+ * Everything here is header-only: recording a transfer or an error is an
+ * inline increment, so the counters can stay enabled in production builds.
+ *
+ * @author Alejandro Beltran
+ * @date October 2026
+ */
+
+#ifndef DRIVER_STATUS_H
+#define DRIVER_STATUS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Status codes returned by the driver libraries
+ *
+ * DRIVER_STATUS_OK is zero so a status can be tested with a simple
+ * `if (status)` to detect any failure.
+ */
+typedef enum driver_status {
+    DRIVER_STATUS_OK = 0,           /**< Operation completed successfully */
+    DRIVER_STATUS_INVALID_ARG,      /**< Channel, register or value out of range */
+    DRIVER_STATUS_CMD_ERROR,        /**< Device flagged the command as invalid */
+    DRIVER_STATUS_NACK,             /**< Device did not acknowledge (I2C) */
+    DRIVER_STATUS_TIMEOUT,          /**< Bus transaction did not complete in time */
+    DRIVER_STATUS_BUSY,             /**< Bus or device busy, operation not started */
+    DRIVER_STATUS_COUNT             /**< Number of status codes (not a valid status) */
+} driver_status_t;
+
+/**
+ * @brief Health counters kept for each device
+ *
+ * Counters are free-running and wrap at 2^32. They can be read at any time
+ * through the getter of each library and dumped over the CDC console.
+ */
+typedef struct {
+    uint32_t transfers;             /**< Bus transfers issued to the device */
+    uint32_t command_errors;        /**< Commands rejected by the device */
+    uint32_t nacks;                 /**< Transfers not acknowledged by the device */
+    uint32_t timeouts;              /**< Transfers that timed out */
+    uint32_t retries;               /**< Transfers repeated after a failure */
+    uint32_t invalid_args;          /**< Calls rejected before reaching the bus */
+    driver_status_t last_error;     /**< Most recent non-OK status */
+} driver_health_t;
+
+/**
+ * @brief Record an error in the health counters
+ *
+ * @param health Counters of the device that produced the error
+ * @param status Status to record (DRIVER_STATUS_OK is ignored)
+ * @return driver_status_t The same status, so the call can be used in a return statement
+ */
+static inline driver_status_t driver_health_error(driver_health_t *health, driver_status_t status)
+{
+    switch (status) {
+        case DRIVER_STATUS_OK:
+            return status;
+        case DRIVER_STATUS_INVALID_ARG:
+            health->invalid_args++;
+            break;
+        case DRIVER_STATUS_CMD_ERROR:
+            health->command_errors++;
+            break;
+        case DRIVER_STATUS_NACK:
+            health->nacks++;
+            break;
+        case DRIVER_STATUS_TIMEOUT:
+            health->timeouts++;
+            break;
+        default:
+            break;
+    }
+    health->last_error = status;
+    return status;
+}
+
+/**
+ * @brief Record a completed bus transfer and its outcome
+ *
+ * @param health Counters of the device addressed by the transfer
+ * @param status Result of the transfer
+ * @return driver_status_t The same status, so the call can be used in a return statement
+ */
+static inline driver_status_t driver_health_transfer(driver_health_t *health, driver_status_t status)
+{
+    health->transfers++;
+    return driver_health_error(health, status);
+}
+
+/**
+ * @brief Record that a failed transfer is about to be repeated
+ *
+ * @param health Counters of the device addressed by the transfer
+ */
+static inline void driver_health_retry(driver_health_t *health)
+{
+    health->retries++;
+}
+
+/**
+ * @brief Clear all counters of a device
+ *
+ * @param health Counters to clear
+ */
+static inline void driver_health_reset(driver_health_t *health)
+{
+    memset(health, 0, sizeof(*health));
+}
+
+/**
+ * @brief Get a short name for a status code
+ *
+ * Intended for console dumps only; the drivers never call it.
+ *
+ * @param status Status code
+ * @return const char* Constant string naming the status
+ */
+static inline const char *driver_status_name(driver_status_t status)
+{
+    switch (status) {
+        case DRIVER_STATUS_OK:          return "OK";
+        case DRIVER_STATUS_INVALID_ARG: return "INVALID_ARG";
+        case DRIVER_STATUS_CMD_ERROR:   return "CMD_ERROR";
+        case DRIVER_STATUS_NACK:        return "NACK";
+        case DRIVER_STATUS_TIMEOUT:     return "TIMEOUT";
+        case DRIVER_STATUS_BUSY:        return "BUSY";
+        default:                        return "UNKNOWN";
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DRIVER_STATUS_H */
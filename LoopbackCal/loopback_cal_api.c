@@ -0,0 +1,230 @@
+/**
+ * @file loopback_cal_api.c
+ * @brief Implementation of the DAC-to-ADC loopback self-calibration
+ *
+ * @author Alejandro Beltran
+ * @date October 2026
+ */
+
+#include "loopback_cal_api.h"
+#include "loopback_cal_platform.h"
+
+#include "mcp48fvxx_api.h"
+#include "ads8866_api.h"
+#include "adc124s021_api.h"
+
+/**
+ * @brief Minimum number of points before convergence is checked
+ */
+#define LOOPBACK_CAL_MIN_POINTS 4
+
+static bool loopback_cal_config_valid(const loopback_cal_config_t *config)
+{
+    if (config == NULL || config->dac_channel > 1 || config->samples == 0 || config->adc_per_dac == 0)
+    {
+        return false;
+    }
+    if (config->adc == LOOPBACK_CAL_ADC_ADC124S021 && config->adc_channel > 3)
+    {
+        return false;
+    }
+    return config->adc == LOOPBACK_CAL_ADC_ADS8866 || config->adc == LOOPBACK_CAL_ADC_ADC124S021;
+}
+
+/**
+ * @brief Write one DAC code, wait for the settle time and average the ADC
+ *
+ * @param config Calibration configuration
+ * @param dac_code DAC code to write
+ * @param measured Pointer to store the averaged 16-bit ADC code (Q8 fraction)
+ * @return driver_status_t DRIVER_STATUS_OK on success, the device error otherwise
+ */
+static driver_status_t loopback_cal_measure(const loopback_cal_config_t *config, uint16_t dac_code, int32_t *measured)
+{
+    if (!mcp48fvxx_set_output(config->dac_channel, dac_code))
+    {
+        return mcp48fvxx_get_health()->last_error;
+    }
+    loopback_cal_platform_delay_us(config->settle_us);
+
+    uint32_t sum = 0;
+    for (uint8_t i = 0; i < config->samples; i++)
+    {
+        if (config->adc == LOOPBACK_CAL_ADC_ADS8866)
+        {
+            sum += ads8866_read_raw();
+        }
+        else
+        {
+            uint16_t value = 0;
+            driver_status_t status = adc124s021_read_channel(config->adc_channel, &value);
+            if (status != DRIVER_STATUS_OK)
+            {
+                return status;
+            }
+            sum += (uint32_t)value << 4; // Normalize 12-bit codes to 16 bits
+        }
+    }
+    // Keep 8 fractional bits of the average
+    *measured = (int32_t)(((uint64_t)sum << 8) / config->samples);
+    return DRIVER_STATUS_OK;
+}
+
+/**
+ * @brief Reverse the low bits of an index
+ *
+ * Used to visit the points coarse-to-fine: 0, N/2, N/4, 3N/4, ...
+ */
+static uint16_t loopback_cal_bit_reverse(uint16_t value, uint8_t bits)
+{
+    uint16_t result = 0;
+    for (uint8_t i = 0; i < bits; i++)
+    {
+        result = (result << 1) | (value & 1);
+        value >>= 1;
+    }
+    return result;
+}
+
+driver_status_t loopback_cal_run_linear(const loopback_cal_config_t *config, loopback_cal_linear_t *result)
+{
+    if (!loopback_cal_config_valid(config) || result == NULL || config->max_points < 3 ||
+        config->max_points > LOOPBACK_CAL_DAC_MAX + 1 || config->dac_min >= config->dac_max ||
+        config->dac_max > LOOPBACK_CAL_DAC_MAX)
+    {
+        return DRIVER_STATUS_INVALID_ARG;
+    }
+
+    uint8_t bits = 0;
+    while ((1U << bits) < config->max_points)
+    {
+        bits++;
+    }
+
+    // Least squares sums of measured = a * dac + b, measured in Q8
+    int64_t sum_x = 0, sum_y = 0, sum_xx = 0, sum_xy = 0;
+    uint16_t points = 0;
+    uint8_t stable = 0;
+    int32_t gain = 0, offset = 0;
+    float scale = (float)config->adc_per_dac / (1L << LOOPBACK_CAL_Q) * 256.0f; // Ideal measured per DAC code, Q8
+
+    result->converged = false;
+    for (uint32_t i = 0; i < (1UL << bits); i++)
+    {
+        uint16_t index = loopback_cal_bit_reverse((uint16_t)i, bits);
+        if (index >= config->max_points)
+        {
+            continue;
+        }
+        uint16_t dac_code = config->dac_min +
+            (uint16_t)(((uint32_t)(config->dac_max - config->dac_min) * index) / (config->max_points - 1));
+
+        int32_t measured = 0;
+        driver_status_t status = loopback_cal_measure(config, dac_code, &measured);
+        if (status != DRIVER_STATUS_OK)
+        {
+            return status;
+        }
+        sum_x += dac_code;
+        sum_y += measured;
+        sum_xx += (int64_t)dac_code * dac_code;
+        sum_xy += (int64_t)dac_code * measured;
+        points++;
+        if (points < 2)
+        {
+            continue;
+        }
+
+        int64_t denominator = (int64_t)points * sum_xx - sum_x * sum_x;
+        if (denominator == 0)
+        {
+            continue;
+        }
+        float a = (float)((int64_t)points * sum_xy - sum_x * sum_y) / (float)denominator;
+        float b = ((float)sum_y - a * (float)sum_x) / (float)points;
+        if (a <= 0.0f)
+        {
+            continue; // Not enough points yet, or the loopback is not connected
+        }
+
+        // Invert the fit: dac = (scale * ideal - b) / a
+        int32_t new_gain = (int32_t)(scale / a * (1L << LOOPBACK_CAL_Q));
+        int32_t new_offset = (int32_t)(-b / a * (1L << LOOPBACK_CAL_Q));
+        if (points > LOOPBACK_CAL_MIN_POINTS &&
+            (uint32_t)((new_gain > gain) ? new_gain - gain : gain - new_gain) <= config->gain_tolerance &&
+            (uint32_t)((new_offset > offset) ? new_offset - offset : offset - new_offset) <= config->offset_tolerance)
+        {
+            stable++;
+        }
+        else
+        {
+            stable = 0;
+        }
+        gain = new_gain;
+        offset = new_offset;
+        if (config->converge_points > 0 && stable >= config->converge_points)
+        {
+            result->converged = true;
+            break;
+        }
+    }
+
+    if (gain <= 0)
+    {
+        return DRIVER_STATUS_INVALID_ARG; // Flat or inverted response
+    }
+    result->gain = gain;
+    result->offset = offset;
+    result->points = points;
+    return DRIVER_STATUS_OK;
+}
+
+driver_status_t loopback_cal_run_table(const loopback_cal_config_t *config, loopback_cal_table_t *result)
+{
+    if (!loopback_cal_config_valid(config) || result == NULL)
+    {
+        return DRIVER_STATUS_INVALID_ARG;
+    }
+
+    int32_t dac[LOOPBACK_CAL_SEGMENTS + 1];
+    int32_t measured[LOOPBACK_CAL_SEGMENTS + 1];
+    for (uint8_t k = 0; k <= LOOPBACK_CAL_SEGMENTS; k++)
+    {
+        uint32_t code = (uint32_t)k << LOOPBACK_CAL_SEGMENT_SHIFT;
+        dac[k] = (code > LOOPBACK_CAL_DAC_MAX) ? LOOPBACK_CAL_DAC_MAX : code;
+        driver_status_t status = loopback_cal_measure(config, (uint16_t)dac[k], &measured[k]);
+        if (status != DRIVER_STATUS_OK)
+        {
+            return status;
+        }
+        if (k > 0 && measured[k] <= measured[k - 1])
+        {
+            return DRIVER_STATUS_INVALID_ARG; // Not monotonic, cannot be inverted
+        }
+    }
+
+    // For each breakpoint find the DAC code whose measurement equals the ideal one
+    uint8_t segment = 0;
+    for (uint8_t k = 0; k <= LOOPBACK_CAL_SEGMENTS; k++)
+    {
+        int64_t target = ((int64_t)k << LOOPBACK_CAL_SEGMENT_SHIFT) * config->adc_per_dac
+                         >> (LOOPBACK_CAL_Q - 8); // Ideal measurement in Q8
+        while (segment < LOOPBACK_CAL_SEGMENTS - 1 && target > measured[segment + 1])
+        {
+            segment++;
+        }
+        // Interpolate (or extrapolate on the end segments)
+        int64_t code = dac[segment] + ((target - measured[segment]) * (dac[segment + 1] - dac[segment])
+                       / (measured[segment + 1] - measured[segment]));
+        if (code < INT16_MIN)
+        {
+            code = INT16_MIN;
+        }
+        else if (code > INT16_MAX)
+        {
+            code = INT16_MAX;
+        }
+        result->code[k] = (int16_t)code;
+    }
+    return DRIVER_STATUS_OK;
+}
\ No newline at end of file
@@ -0,0 +1,164 @@
+/**
+ * @file loopback_cal_api.h
+ * @brief DAC-to-ADC loopback self-calibration for the MCP48FVXX
+ *
+ * This module steps an MCP48FVXX channel through its range, measures each
+ * step with the ADS8866 or one ADC124S021 channel wired back to the DAC
+ * output, and produces a compact integer correction for that DAC channel:
+ *
+ * - A linear gain/offset pair, fitted by least squares. Points are taken
+ *   coarse-to-fine over the range and the run stops as soon as the fit
+ *   converges.
+ * - A piecewise-linear table of LOOPBACK_CAL_SEGMENTS segments that also
+ *   corrects non-linearity near the rails.
+ *
+ * Both corrections map an ideal DAC code to the code that must be written
+ * to obtain it, and are applied with the inline functions at the end of
+ * this file using integer math only.
+ *
+ * @author Alejandro Beltran
+ * @date October 2026
+ */
+
+#ifndef LOOPBACK_CAL_API_H
+#define LOOPBACK_CAL_API_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "driver_status.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Full-scale DAC code */
+#define LOOPBACK_CAL_DAC_MAX        4095
+/** @brief Number of segments of the piecewise-linear table */
+#define LOOPBACK_CAL_SEGMENTS       16
+/** @brief log2 of the DAC codes covered by one segment (4096 / LOOPBACK_CAL_SEGMENTS) */
+#define LOOPBACK_CAL_SEGMENT_SHIFT  8
+/** @brief Number of fractional bits of the linear correction */
+#define LOOPBACK_CAL_Q              16
+
+/**
+ * @brief ADC used to measure the DAC output
+ */
+typedef enum loopback_cal_adc {
+    LOOPBACK_CAL_ADC_ADS8866 = 0,   /**< ADS8866, 16-bit */
+    LOOPBACK_CAL_ADC_ADC124S021     /**< One ADC124S021 channel, 12-bit scaled to 16-bit */
+} loopback_cal_adc_t;
+
+/**
+ * @brief Calibration run configuration
+ *
+ * ADC codes are normalized to 16 bits before fitting, so `adc_per_dac` is
+ * the ideal number of 16-bit ADC codes per DAC code. With the same reference
+ * on both devices and a 12-bit DAC this is 16.0 (16 << 16).
+ */
+typedef struct {
+    uint8_t dac_channel;            /**< MCP48FVXX channel to calibrate */
+    loopback_cal_adc_t adc;         /**< ADC used to measure the output */
+    uint8_t adc_channel;            /**< ADC124S021 channel (0-3), ignored for the ADS8866 */
+    uint32_t adc_per_dac;           /**< Ideal 16-bit ADC codes per DAC code (Q16.16) */
+    uint16_t dac_min;               /**< Lowest DAC code used by the linear fit */
+    uint16_t dac_max;               /**< Highest DAC code used by the linear fit */
+    uint16_t max_points;            /**< Maximum points measured by the linear fit (3-4096) */
+    uint8_t samples;                /**< ADC samples averaged per point (1-255) */
+    uint32_t settle_us;             /**< Settle time after each DAC step */
+    uint32_t gain_tolerance;        /**< Convergence: largest gain change between points (Q16.16) */
+    uint32_t offset_tolerance;      /**< Convergence: largest offset change between points (Q16.16 DAC codes) */
+    uint8_t converge_points;        /**< Consecutive points within tolerance needed to stop early */
+} loopback_cal_config_t;
+
+/**
+ * @brief Linear correction of one DAC channel
+ *
+ * corrected = (ideal * gain + offset) >> LOOPBACK_CAL_Q
+ */
+typedef struct {
+    int32_t gain;                   /**< Correction gain (Q16.16) */
+    int32_t offset;                 /**< Correction offset in DAC codes (Q16.16) */
+    uint16_t points;                /**< Points measured before convergence */
+    bool converged;                 /**< true if the run stopped on convergence */
+} loopback_cal_linear_t;
+
+/**
+ * @brief Piecewise-linear correction of one DAC channel
+ *
+ * code[k] is the DAC code to write for the ideal code k << LOOPBACK_CAL_SEGMENT_SHIFT.
+ */
+typedef struct {
+    int16_t code[LOOPBACK_CAL_SEGMENTS + 1];   /**< Corrected code at each breakpoint */
+} loopback_cal_table_t;
+
+/**
+ * @brief Run a linear gain/offset calibration
+ *
+ * Blocks until the fit converges or max_points have been measured.
+ *
+ * @param config Calibration configuration
+ * @param result Pointer to store the linear correction
+ * @return driver_status_t DRIVER_STATUS_OK on success, DRIVER_STATUS_INVALID_ARG for a bad
+ *         configuration or a flat response, or the error of the failing device
+ */
+driver_status_t loopback_cal_run_linear(const loopback_cal_config_t *config, loopback_cal_linear_t *result);
+
+/**
+ * @brief Run a piecewise-linear calibration
+ *
+ * Measures the DAC at each of the LOOPBACK_CAL_SEGMENTS + 1 breakpoints over
+ * the full range and inverts the measured response. dac_min, dac_max,
+ * max_points and the convergence fields of the configuration are ignored.
+ *
+ * @param config Calibration configuration
+ * @param result Pointer to store the correction table
+ * @return driver_status_t DRIVER_STATUS_OK on success, DRIVER_STATUS_INVALID_ARG for a bad
+ *         configuration or a non-monotonic response, or the error of the failing device
+ */
+driver_status_t loopback_cal_run_table(const loopback_cal_config_t *config, loopback_cal_table_t *result);
+
+/**
+ * @brief Apply a linear correction to an ideal DAC code
+ *
+ * @param cal Linear correction
+ * @param ideal Ideal DAC code (0-4095)
+ * @return uint16_t DAC code to write, clamped to 0-4095
+ */
+static inline uint16_t loopback_cal_apply_linear(const loopback_cal_linear_t *cal, uint16_t ideal)
+{
+    int32_t code = ((int32_t)ideal * cal->gain + cal->offset + (1L << (LOOPBACK_CAL_Q - 1))) >> LOOPBACK_CAL_Q;
+    if (code < 0) {
+        return 0;
+    }
+    return (code > LOOPBACK_CAL_DAC_MAX) ? LOOPBACK_CAL_DAC_MAX : (uint16_t)code;
+}
+
+/**
+ * @brief Apply a piecewise-linear correction to an ideal DAC code
+ *
+ * @param cal Correction table
+ * @param ideal Ideal DAC code (0-4095)
+ * @return uint16_t DAC code to write, clamped to 0-4095
+ */
+static inline uint16_t loopback_cal_apply_table(const loopback_cal_table_t *cal, uint16_t ideal)
+{
+    uint16_t segment = ideal >> LOOPBACK_CAL_SEGMENT_SHIFT;
+    if (segment >= LOOPBACK_CAL_SEGMENTS) {
+        segment = LOOPBACK_CAL_SEGMENTS - 1;
+    }
+    int32_t fraction = ideal - (segment << LOOPBACK_CAL_SEGMENT_SHIFT);
+    int32_t start = cal->code[segment];
+    int32_t code = start + (((cal->code[segment + 1] - start) * fraction
+                   + (1L << (LOOPBACK_CAL_SEGMENT_SHIFT - 1))) >> LOOPBACK_CAL_SEGMENT_SHIFT);
+    if (code < 0) {
+        return 0;
+    }
+    return (code > LOOPBACK_CAL_DAC_MAX) ? LOOPBACK_CAL_DAC_MAX : (uint16_t)code;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LOOPBACK_CAL_API_H */
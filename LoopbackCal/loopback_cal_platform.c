@@ -0,0 +1,17 @@
+/**
+ * @file loopback_cal_platform.c
+ * @brief Implementation of platform-specific functions for the loopback calibration
+ *
+ * These functions should be implemented according to the specific platform
+ * being used.
+ *
+ * @author Alejandro Beltran
+ * @date October 2026
+ */
+
+#include "loopback_cal_platform.h"
+
+void loopback_cal_platform_delay_us(uint32_t delay_us)
+{
+    // TODO - Implement a microsecond busy-wait for the target platform
+}
\ No newline at end of file
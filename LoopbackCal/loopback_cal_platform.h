@@ -0,0 +1,34 @@
+/**
+ * @file loopback_cal_platform.h
+ * @brief Platform-specific interface for the DAC-to-ADC loopback calibration
+ *
+ * This file declares the hardware abstraction layer functions needed by
+ * the calibration routine.
+ *
+ * @author Alejandro Beltran
+ * @date October 2026
+ */
+
+#ifndef LOOPBACK_CAL_PLATFORM_H
+#define LOOPBACK_CAL_PLATFORM_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Busy-wait for the given number of microseconds
+ *
+ * Used to let the DAC output and the ADC input settle after each step.
+ *
+ * @param delay_us Delay in microseconds
+ */
+void loopback_cal_platform_delay_us(uint32_t delay_us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LOOPBACK_CAL_PLATFORM_H */
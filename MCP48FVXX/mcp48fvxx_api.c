@@ -8,6 +8,39 @@
 #include "mcp48fvxx_api.h"
 #include "mcp48fvxx_platform.h"
 
+/**
+ * @brief Health counters of the DAC
+ */
+static driver_health_t mcp48fvxx_health;
+
+/**
+ * @brief Record an error and notify the platform error handler
+ *
+ * @param status Error code to report
+ * @return bool Always false, so the call can be used in a return statement
+ */
+static bool mcp48fvxx_fail(driver_status_t status) {
+    driver_health_error(&mcp48fvxx_health, status);
+    mcp48fvxx_error_handler(status);
+    return false;
+}
+
+/**
+ * @brief Send a command word and check the command-valid bit of the response
+ *
+ * @param command 24-bit command word
+ * @param response Pointer to store the 24-bit response
+ * @return bool true if the DAC accepted the command, false otherwise
+ */
+static bool mcp48fvxx_transfer(uint32_t command, uint32_t *response) {
+    *response = mcp48fvxx_spi_transfer(command);
+    mcp48fvxx_health.transfers++;
+    if(!(*response & MCP48FVXX_CMD_VALID)) {
+        return mcp48fvxx_fail(DRIVER_STATUS_CMD_ERROR);
+    }
+    return true;
+}
+
 /**
  * @brief Set the output value of a DAC channel
  *
@@ -19,24 +52,42 @@
  * @return bool true if successful, false if an error occurred
  */
 bool mcp48fvxx_set_output(uint8_t channel, uint16_t value) {
-    if(channel > 1) {
-        mcp48fvxx_error_handler("Invalid channel specified. Use 0 for Channel A or 1 for Channel B.");
-        return 0;
-    }else if (value > 4095) {
-        mcp48fvxx_error_handler("Invalid value specified. Value must be in the range 0-4095.");
-        return 0;
+    uint32_t command = 0;
+    if(!mcp48fvxx_output_frame(channel, value, &command)) {
+        return false;
+    }
+    return mcp48fvxx_write_frame(command);
+}
+
+/**
+ * @brief Encode an output command frame for a DAC channel
+ *
+ * @param channel Channel selection (0 for Channel A, 1 for Channel B)
+ * @param value 12-bit output value (0-4095)
+ * @param frame Pointer to store the encoded 24-bit command word
+ * @return bool true if successful, false if an argument is out of range
+ */
+bool mcp48fvxx_output_frame(uint8_t channel, uint16_t value, uint32_t *frame) {
+    if(channel > 1 || value > 4095) {
+        return mcp48fvxx_fail(DRIVER_STATUS_INVALID_ARG);
     }
-    uint32_t result = 0;
     uint32_t command = 0;
     // Construct the command word
     command |= (channel == MCP48FVXX_CHANNEL_B) ? MCP48FVXX_CHANNEL_B_ADDRESS : MCP48FVXX_CHANNEL_A_ADDRESS; // Select channel
     command |= value;
-    result = mcp48fvxx_spi_transfer(command);
-    if(!(result & 0x10000)) {
-        mcp48fvxx_error_handler("Error in address + command combination.");
-        return 0;
-    }
-    return 1;
+    *frame = command;
+    return true;
+}
+
+/**
+ * @brief Send a pre-encoded command frame to the DAC
+ *
+ * @param frame 24-bit command word
+ * @return bool true if the DAC accepted the command, false otherwise
+ */
+bool mcp48fvxx_write_frame(uint32_t frame) {
+    uint32_t result = 0;
+    return mcp48fvxx_transfer(frame, &result);
 }
 
 /**
@@ -51,32 +102,44 @@ bool mcp48fvxx_set_output(uint8_t channel, uint16_t value) {
  */
 bool mcp48fvxx_channel_on_off(uint8_t channel, bool on_off){
     if(channel > 1) {
-        mcp48fvxx_error_handler("Invalid channel specified. Use 0 for Channel A or 1 for Channel B.");
-        return 0;
+        return mcp48fvxx_fail(DRIVER_STATUS_INVALID_ARG);
     }
-    
+    uint8_t bits = on_off ? MCP48FVXX_CHANNEL_ON : MCP48FVXX_CHANNEL_OFF;
+    return mcp48fvxx_update_power(0x03 << (channel * 2), bits << (channel * 2));
+}
+
+/**
+ * @brief Update several power-down bits with one read-modify-write
+ *
+ * @param mask Bits to replace (0x00-0x0F)
+ * @param bits New value of the selected bits
+ * @return bool true if successful, false if an error occurred
+ */
+bool mcp48fvxx_update_power(uint8_t mask, uint8_t bits){
+    if(mask > 0x0F) {
+        return mcp48fvxx_fail(DRIVER_STATUS_INVALID_ARG);
+    }
+
     uint32_t result = 0;
     uint32_t command = 0;
     // Construct the command word
     command |= MCP48FVXX_ON_OFF_REG | MCP48FVXX_READ;
-    result = mcp48fvxx_spi_transfer(command);
-    
-    if(!(result & 0x10000)) {
-        mcp48fvxx_error_handler("Error in address + command combination.");
-        return 0;
+    if(!mcp48fvxx_transfer(command, &result)) {
+        return false;
     }
     
     result &= 0x0F;
-    result &= ~(0x03 << (channel * 2));
-    result |= on_off ? MCP48FVXX_CHANNEL_ON << (channel * 2) : MCP48FVXX_CHANNEL_OFF << (channel * 2);
+    result &= ~mask;
+    result |= bits & mask;
     command = 0;
     command |= MCP48FVXX_ON_OFF_REG | result; 
-    result = mcp48fvxx_spi_transfer(command);
-    
-    if(!(result & 0x10000)) {
-        mcp48fvxx_error_handler("Error in address + command combination.");
-        return 0;
-    }
-    
-    return 1;
+    return mcp48fvxx_transfer(command, &result);
+}
+
+const driver_health_t* mcp48fvxx_get_health(void){
+    return &mcp48fvxx_health;
+}
+
+void mcp48fvxx_reset_health(void){
+    driver_health_reset(&mcp48fvxx_health);
 }
\ No newline at end of file
@@ -40,6 +40,8 @@ extern "C" {
 #define MCP48FVXX_CHANNEL_ON 0x00
 /** @brief Channel off (power down) */
 #define MCP48FVXX_CHANNEL_OFF 0x01
+/** @brief Response bit set by the DAC when the address + command combination is valid */
+#define MCP48FVXX_CMD_VALID 0x10000
 
 /**
  * @brief Set the output value of a DAC channel
@@ -59,6 +61,59 @@ bool mcp48fvxx_set_output(uint8_t channel, uint16_t value);
  */
 bool mcp48fvxx_channel_on_off(uint8_t channel, bool on_off);
 
+/**
+ * @brief Update several power-down bits with one read-modify-write
+ * 
+ * Reads the power-down register, replaces the bits selected by `mask` with
+ * those of `bits` and writes it back. Each channel uses two bits, channel A
+ * in bits 1:0 and channel B in bits 3:2 (00 on, 01 off).
+ * 
+ * @param mask Bits to replace (0x00-0x0F)
+ * @param bits New value of the selected bits
+ * @return bool true if successful, false if an error occurred
+ */
+bool mcp48fvxx_update_power(uint8_t mask, uint8_t bits);
+
+/**
+ * @brief Encode an output command frame for a DAC channel
+ * 
+ * Validates the arguments once and returns the 24-bit command word that
+ * mcp48fvxx_set_output() would send. Since the value occupies the low
+ * 12 bits, a frame encoded with value 0 can be reused as a base and
+ * OR-ed with any in-range value at run time.
+ * 
+ * @param channel Channel selection (0 for Channel A, 1 for Channel B)
+ * @param value 12-bit output value (0-4095)
+ * @param frame Pointer to store the encoded 24-bit command word
+ * @return bool true if successful, false if an argument is out of range
+ */
+bool mcp48fvxx_output_frame(uint8_t channel, uint16_t value, uint32_t *frame);
+
+/**
+ * @brief Send a pre-encoded command frame to the DAC
+ * 
+ * Fast path for control loops: no argument validation is done, only the
+ * command-valid bit of the response is checked and counted.
+ * 
+ * @param frame 24-bit command word, usually built with mcp48fvxx_output_frame()
+ * @return bool true if the DAC accepted the command, false otherwise
+ */
+bool mcp48fvxx_write_frame(uint32_t frame);
+
+/**
+ * @brief Get the health counters of the DAC
+ * 
+ * The counters are updated on every SPI transfer and every rejected call.
+ * 
+ * @return const driver_health_t* Pointer to the live counters
+ */
+const driver_health_t* mcp48fvxx_get_health(void);
+
+/**
+ * @brief Clear the health counters of the DAC
+ */
+void mcp48fvxx_reset_health(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -14,7 +14,7 @@ uint32_t mcp48fvxx_spi_transfer(uint32_t command_24bit) {
     return 0;    
 }
 
-void mcp48fvxx_error_handler(char *message){
+void mcp48fvxx_error_handler(driver_status_t status){
     // TODO: Implement for the target platform.
     return;
 }
\ No newline at end of file
@@ -14,6 +14,8 @@
 
 #include <stdint.h>
 
+#include "driver_status.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -30,14 +32,16 @@ extern "C" {
 uint32_t mcp48fvxx_spi_transfer(uint32_t command_24bit);
 
 /**
- * @brief Handle error messages from the DAC library
+ * @brief Handle errors reported by the DAC library
  * 
- * This function should implement appropriate error handling
- * for the target platform (e.g., logging, display, etc.).
+ * This function is called after the error has been recorded in the
+ * health counters. It should implement any additional error handling
+ * for the target platform (e.g., raising a flag, setting a LED, etc.)
+ * and must return quickly; leave it empty if the counters are enough.
  * 
- * @param message Error message string
+ * @param status Error code (never DRIVER_STATUS_OK)
  */
-void mcp48fvxx_error_handler(char *message);
+void mcp48fvxx_error_handler(driver_status_t status);
 
 #ifdef __cplusplus
 }
@@ -9,11 +9,278 @@
 #include "mcp4xxx_api.h"
 #include "mcp4xxx_platform.h"
 
+#include <string.h>
+
+/**
+ * @brief Ramp of one wiper
+ *
+ * The wiper moves along a straight line from `start` to `target` over
+ * `ticks` ticks; `position` is the last position sent to the device at
+ * `address`.
+ */
+typedef struct {
+    bool active;
+    uint8_t address;
+    uint16_t start;
+    uint16_t target;
+    uint16_t position;
+    uint16_t elapsed;
+    uint16_t ticks;
+} mcp4xxx_ramp_t;
+
+/**
+ * @brief Per-device state, selected by the A0-A2 bits of the address
+ *
+ * `reg` shadows registers WIPER_0 to TCON; bit n of `valid` is set while
+ * `reg[n]` matches the device. `nv_callback` and `nv_polls` track the
+ * asynchronous non-volatile write in flight, if `nv_pending` is set.
+ * `ramp` holds the ramp of each wiper.
+ */
+typedef struct {
+    driver_health_t health;
+    mcp4xxx_model_t model;
+    uint8_t valid;
+    uint16_t reg[MCP4XXX_SHADOW_REGISTERS];
+    bool nv_pending;
+    uint8_t nv_address;
+    uint16_t nv_polls;
+    mcp4xxx_nv_callback_t nv_callback;
+    mcp4xxx_ramp_t ramp[2];
+} mcp4xxx_device_t;
+
+static mcp4xxx_device_t mcp4xxx_devices[MCP4XXX_MAX_DEVICES];
+
+static bool mcp4xxx_high_speed;
+
+static inline mcp4xxx_device_t* mcp4xxx_device_of(uint8_t device_address)
+{
+    return &mcp4xxx_devices[device_address & MCP4XXX_DEVICE_MASK];
+}
+
+/**
+ * @brief Get the health counters of a device from its I2C address
+ */
+static inline driver_health_t* mcp4xxx_health_of(uint8_t device_address)
+{
+    return &mcp4xxx_device_of(device_address)->health;
+}
+
+static inline bool mcp4xxx_is_single(mcp4xxx_model_t model)
+{
+    return model >= MCP4XXX_MODEL_MCP4541 && model <= MCP4XXX_MODEL_MCP4562;
+}
+
+/**
+ * @brief Check that a register exists on the configured model
+ */
+static inline bool mcp4xxx_has_register(const mcp4xxx_device_t *device, uint8_t reg_address)
+{
+    return !mcp4xxx_is_single(device->model) ||
+           (reg_address != WIPER_1_ADDRESS && reg_address != NV_WIPER_1_ADDRESS);
+}
+
+/**
+ * @brief Check whether a write to a register starts an EEPROM cycle
+ */
+static inline bool mcp4xxx_is_nonvolatile(uint8_t reg_address)
+{
+    return reg_address == NV_WIPER_0_ADDRESS || reg_address == NV_WIPER_1_ADDRESS || reg_address > STATUS_ADDRESS;
+}
+
+static inline void mcp4xxx_cache_store(mcp4xxx_device_t *device, uint8_t reg_address, uint16_t data)
+{
+    if (reg_address < MCP4XXX_SHADOW_REGISTERS)
+    {
+        device->reg[reg_address] = data;
+        device->valid |= (uint8_t)(1U << reg_address);
+    }
+}
+
+static inline void mcp4xxx_cache_drop(mcp4xxx_device_t *device, uint8_t reg_address)
+{
+    if (reg_address < MCP4XXX_SHADOW_REGISTERS)
+    {
+        device->valid &= (uint8_t)~(1U << reg_address);
+    }
+}
+
+/**
+ * @brief Check whether a failed transaction may succeed if repeated
+ */
+static inline bool mcp4xxx_retryable(driver_status_t status)
+{
+    return status == DRIVER_STATUS_NACK || status == DRIVER_STATUS_TIMEOUT;
+}
+
+static driver_status_t mcp4xxx_bus_write(uint8_t device_address, uint16_t data)
+{
+    driver_health_t *health = mcp4xxx_health_of(device_address);
+    driver_status_t status = mcp4xxx_i2c_write(device_address, data);
+    for (uint8_t retry = 0; retry < MCP4XXX_I2C_RETRIES && mcp4xxx_retryable(status); retry++)
+    {
+        driver_health_retry(health);
+        status = mcp4xxx_i2c_write(device_address, data);
+    }
+    return driver_health_transfer(health, status);
+}
+
+/**
+ * @brief Send a single command byte
+ *
+ * Only increment and decrement commands are sent on their own. A timeout
+ * may come after the device has already moved the wiper, so they are not
+ * retried; the caller invalidates the cached wiper instead.
+ */
+static driver_status_t mcp4xxx_bus_write_byte(uint8_t device_address, uint8_t data)
+{
+    return driver_health_transfer(mcp4xxx_health_of(device_address),
+                                  mcp4xxx_i2c_write_byte(device_address, data));
+}
+
+static driver_status_t mcp4xxx_bus_read(uint8_t device_address, uint8_t command, uint16_t *data)
+{
+    driver_health_t *health = mcp4xxx_health_of(device_address);
+    driver_status_t status = mcp4xxx_i2c_read(device_address, command, data);
+    for (uint8_t retry = 0; retry < MCP4XXX_I2C_RETRIES && mcp4xxx_retryable(status); retry++)
+    {
+        driver_health_retry(health);
+        status = mcp4xxx_i2c_read(device_address, command, data);
+    }
+    return driver_health_transfer(health, status);
+}
+
+/**
+ * @brief Send several bytes in one transaction
+ *
+ * Only transactions that can be repeated without side effects are retried.
+ */
+static driver_status_t mcp4xxx_bus_write_buffer(uint8_t device_address, const uint8_t *data, uint16_t length, bool retry)
+{
+    driver_health_t *health = mcp4xxx_health_of(device_address);
+    driver_status_t status = mcp4xxx_i2c_write_buffer(device_address, data, length);
+    for (uint8_t attempt = 0; retry && attempt < MCP4XXX_I2C_RETRIES && mcp4xxx_retryable(status); attempt++)
+    {
+        driver_health_retry(health);
+        status = mcp4xxx_i2c_write_buffer(device_address, data, length);
+    }
+    return driver_health_transfer(health, status);
+}
+
+/**
+ * @brief Read a register from the device, bypassing the cache
+ */
+static driver_status_t mcp4xxx_read_register(uint8_t device_address, uint8_t reg_address, uint16_t *data)
+{
+    uint8_t command = (reg_address << 4) | READ_CMD;
+    driver_status_t status = mcp4xxx_bus_read(device_address, command, data);
+    mcp4xxx_device_t *device = mcp4xxx_device_of(device_address);
+    if (status == DRIVER_STATUS_OK)
+    {
+        mcp4xxx_cache_store(device, reg_address, *data);
+    }
+    else
+    {
+        mcp4xxx_cache_drop(device, reg_address);
+    }
+    return status;
+}
+
+/**
+ * @brief Limit a wiper movement to what the device will actually perform
+ */
+static int16_t mcp4xxx_clamp_steps(uint8_t device_address, mcp4xxx_wiper_t wiper, int16_t steps)
+{
+    mcp4xxx_device_t *device = mcp4xxx_device_of(device_address);
+    int16_t max = (int16_t)mcp4xxx_max_wiper(device_address);
+    int16_t lower = -max;
+    int16_t upper = max;
+    if (device->valid & (1U << wiper))
+    {
+        lower = -(int16_t)device->reg[wiper];
+        if (device->model != MCP4XXX_MODEL_UNKNOWN)
+        {
+            upper = max - (int16_t)device->reg[wiper];
+        }
+    }
+    return (steps < lower) ? lower : (steps > upper) ? upper : steps;
+}
+
+/**
+ * @brief Follow a completed wiper movement in the cache
+ *
+ * The wiper saturates at zero-scale and full-scale; without a model the
+ * full-scale value is unknown, so upward movements invalidate the entry.
+ */
+static void mcp4xxx_cache_move(uint8_t device_address, mcp4xxx_wiper_t wiper, int16_t steps)
+{
+    mcp4xxx_device_t *device = mcp4xxx_device_of(device_address);
+    if (steps > 0 && device->model == MCP4XXX_MODEL_UNKNOWN)
+    {
+        mcp4xxx_cache_drop(device, (uint8_t)wiper);
+        return;
+    }
+    int16_t value = (int16_t)device->reg[wiper] + steps;
+    int16_t max = (int16_t)mcp4xxx_max_wiper(device_address);
+    device->reg[wiper] = (uint16_t)((value < 0) ? 0 : (value > max) ? max : value);
+}
+
+/**
+ * @brief Send a single increment or decrement command
+ */
+static bool mcp4xxx_step(uint8_t device_address, mcp4xxx_wiper_t wiper, uint8_t command, int16_t direction)
+{
+    mcp4xxx_device_t *device = mcp4xxx_device_of(device_address);
+    if (!mcp4xxx_has_wiper(device_address, wiper))
+    {
+        driver_health_error(&device->health, DRIVER_STATUS_INVALID_ARG);
+        return false;
+    }
+    if (mcp4xxx_bus_write_byte(device_address, ((uint8_t)wiper << 4) | command) != DRIVER_STATUS_OK)
+    {
+        mcp4xxx_cache_drop(device, (uint8_t)wiper);
+        return false;
+    }
+    mcp4xxx_cache_move(device_address, wiper, direction);
+    return true;
+}
+
+bool mcp4xxx_configure(uint8_t device_address, mcp4xxx_model_t model)
+{
+    mcp4xxx_device_t *device = mcp4xxx_device_of(device_address);
+    if (model > MCP4XXX_MODEL_MCP4662)
+    {
+        driver_health_error(&device->health, DRIVER_STATUS_INVALID_ARG);
+        return false;
+    }
+    device->model = model;
+    device->valid = 0;
+    return true;
+}
+
+uint16_t mcp4xxx_max_wiper(uint8_t device_address)
+{
+    switch (mcp4xxx_device_of(device_address)->model)
+    {
+        case MCP4XXX_MODEL_MCP4541:
+        case MCP4XXX_MODEL_MCP4542:
+        case MCP4XXX_MODEL_MCP4641:
+        case MCP4XXX_MODEL_MCP4642:
+            return 128;
+        default:
+            return 256;
+    }
+}
+
+bool mcp4xxx_has_wiper(uint8_t device_address, mcp4xxx_wiper_t wiper)
+{
+    return wiper <= WIPER_1 && mcp4xxx_has_register(mcp4xxx_device_of(device_address), (uint8_t)wiper);
+}
+
 bool mcp4xxx_check(uint8_t device_address)
 {
-    // Check device presence by reading the STATUS register
-    uint16_t tcon = mcpxxx_read(device_address, TCON_ADDRESS);
-    if (tcon != 0x1FF)
+    // Always go to the bus: a cached TCON says nothing about the device being present
+    uint16_t tcon = 0xFFFF;
+    if (mcp4xxx_read_register(device_address, TCON_ADDRESS, &tcon) != DRIVER_STATUS_OK || tcon != 0x1FF)
     {
         return false; // Device not responding
     }
@@ -22,21 +289,97 @@ bool mcp4xxx_check(uint8_t device_address)
 
 bool mcpxxx_write(uint8_t device_address, uint8_t reg_address, uint16_t data)
 {
-    if (data > 0x1FF) // Check if data exceeds 9 bits
+    mcp4xxx_device_t *device = mcp4xxx_device_of(device_address);
+    if (data > 0x1FF || !mcp4xxx_has_register(device, reg_address)) // Check if data exceeds 9 bits
     {
+        driver_health_error(&device->health, DRIVER_STATUS_INVALID_ARG);
         return false; // Invalid data for MCP4XXX
     }
+    if (mcp4xxx_high_speed && mcp4xxx_is_nonvolatile(reg_address))
+    {
+        // High-speed transactions end with a repeated START, and the EEPROM
+        // write cycle only starts at a STOP
+        driver_health_error(&device->health, DRIVER_STATUS_INVALID_ARG);
+        return false;
+    }
+    if (device->nv_pending && mcp4xxx_is_nonvolatile(reg_address))
+    {
+        driver_health_error(&device->health, DRIVER_STATUS_BUSY);
+        return false; // EEPROM write in progress
+    }
 
     uint16_t command = (reg_address << 4) | WRITE_CMD | ((data & 0x1FF) >> 8);
     command <<= 8;
     command |= (data & 0xFF);
-    return mcp4xxx_i2c_write(device_address, command);
+    if (mcp4xxx_bus_write(device_address, command) != DRIVER_STATUS_OK)
+    {
+        mcp4xxx_cache_drop(device, reg_address);
+        return false;
+    }
+    mcp4xxx_cache_store(device, reg_address, data);
+    return true;
+}
+
+bool mcp4xxx_write_batch(uint8_t device_address, const mcp4xxx_write_t *writes, uint8_t count)
+{
+    mcp4xxx_device_t *device = mcp4xxx_device_of(device_address);
+    uint8_t buffer[2 * MCP4XXX_MAX_BATCH];
+
+    if (writes == NULL || count == 0 || count > MCP4XXX_MAX_BATCH)
+    {
+        driver_health_error(&device->health, DRIVER_STATUS_INVALID_ARG);
+        return false;
+    }
+    for (uint8_t i = 0; i < count; i++)
+    {
+        uint8_t reg_address = writes[i].reg_address;
+        uint16_t data = writes[i].data;
+        if (data > 0x1FF || !mcp4xxx_has_register(device, reg_address) ||
+            (reg_address != WIPER_0_ADDRESS && reg_address != WIPER_1_ADDRESS && reg_address != TCON_ADDRESS))
+        {
+            driver_health_error(&device->health, DRIVER_STATUS_INVALID_ARG);
+            return false;
+        }
+        buffer[2 * i] = (reg_address << 4) | WRITE_CMD | (data >> 8);
+        buffer[2 * i + 1] = data & 0xFF;
+    }
+
+    bool ok = mcp4xxx_bus_write_buffer(device_address, buffer, 2 * count, true) == DRIVER_STATUS_OK;
+    for (uint8_t i = 0; i < count; i++)
+    {
+        if (ok)
+        {
+            mcp4xxx_cache_store(device, writes[i].reg_address, writes[i].data);
+        }
+        else
+        {
+            mcp4xxx_cache_drop(device, writes[i].reg_address);
+        }
+    }
+    return ok;
 }
 
 uint16_t mcpxxx_read(uint8_t device_address, uint8_t reg_address)
 {
-    uint8_t command = (reg_address << 4) | READ_CMD;
-    return mcp4xxx_i2c_read(device_address, command);
+    mcp4xxx_device_t *device = mcp4xxx_device_of(device_address);
+    if (!mcp4xxx_has_register(device, reg_address))
+    {
+        driver_health_error(&device->health, DRIVER_STATUS_INVALID_ARG);
+        return 0xFFFF;
+    }
+    if (reg_address < MCP4XXX_SHADOW_REGISTERS && (device->valid & (1U << reg_address)))
+    {
+        return device->reg[reg_address];
+    }
+
+    // STATUS is never cached: EEWA and the WP/SHDN bits change on the device
+    // without any bus write, so no write could invalidate a copy
+    uint16_t data = 0xFFFF;
+    if (mcp4xxx_read_register(device_address, reg_address, &data) != DRIVER_STATUS_OK)
+    {
+        return 0xFFFF;
+    }
+    return data;
 }
 
 bool mcp4xxx_set_wiper(uint8_t device_address, mcp4xxx_wiper_t wiper, uint16_t value)
@@ -45,6 +388,15 @@ bool mcp4xxx_set_wiper(uint8_t device_address, mcp4xxx_wiper_t wiper, uint16_t v
     return mcpxxx_write(device_address, reg_address, value);
 }
 
+bool mcp4xxx_set_wipers(uint8_t device_address, uint16_t wiper0, uint16_t wiper1)
+{
+    const mcp4xxx_write_t writes[] = {
+        { WIPER_0_ADDRESS, wiper0 },
+        { WIPER_1_ADDRESS, wiper1 },
+    };
+    return mcp4xxx_write_batch(device_address, writes, 2);
+}
+
 uint16_t mcp4xxx_get_wiper(uint8_t device_address, mcp4xxx_wiper_t wiper)
 {
     uint8_t reg_address = (uint8_t)wiper;
@@ -53,25 +405,504 @@ uint16_t mcp4xxx_get_wiper(uint8_t device_address, mcp4xxx_wiper_t wiper)
 
 bool mcp4xxx_increment_wiper(uint8_t device_address, mcp4xxx_wiper_t wiper)
 {
-    uint8_t command = ((uint8_t)wiper << 4) | INCREMENT_CMD;
-    return mcp4xxx_i2c_write_byte(device_address, command);
+    return mcp4xxx_step(device_address, wiper, INCREMENT_CMD, 1);
 }
 
 bool mcp4xxx_decrement_wiper(uint8_t device_address, mcp4xxx_wiper_t wiper)
 {
-    uint8_t command = ((uint8_t)wiper << 4) | DECREMENT_CMD;
-    return mcp4xxx_i2c_write_byte(device_address, command);
+    return mcp4xxx_step(device_address, wiper, DECREMENT_CMD, -1);
+}
+
+bool mcp4xxx_step_wiper(uint8_t device_address, mcp4xxx_wiper_t wiper, int16_t steps)
+{
+    mcp4xxx_device_t *device = mcp4xxx_device_of(device_address);
+    if (!mcp4xxx_has_wiper(device_address, wiper))
+    {
+        driver_health_error(&device->health, DRIVER_STATUS_INVALID_ARG);
+        return false;
+    }
+
+    steps = mcp4xxx_clamp_steps(device_address, wiper, steps);
+    if (steps == 0)
+    {
+        return true; // Already at the requested end of the range
+    }
+    uint16_t count = (uint16_t)((steps > 0) ? steps : -steps);
+    // On the stack and sized to the move (at most MCP4XXX_MAX_STEPS bytes),
+    // so a call from an interrupt cannot overwrite the commands of another
+    uint8_t commands[count];
+    memset(commands, ((uint8_t)wiper << 4) | ((steps > 0) ? INCREMENT_CMD : DECREMENT_CMD), count);
+
+    if (mcp4xxx_bus_write_buffer(device_address, commands, count, false) != DRIVER_STATUS_OK)
+    {
+        mcp4xxx_cache_drop(device, (uint8_t)wiper);
+        return false;
+    }
+    mcp4xxx_cache_move(device_address, wiper, steps);
+    return true;
 }
 
 bool mcp4xxx_set_nv_wiper(uint8_t device_address, mcp4xxx_wiper_t wiper, uint16_t value)
 {
     uint8_t reg_address = (wiper == WIPER_0) ? NV_WIPER_0_ADDRESS : NV_WIPER_1_ADDRESS;
-    mcpxxx_write(device_address, reg_address, value);
-    return true; // Assume write is successful, as MCP4XXX does not provide a direct confirmation
+    return mcpxxx_write(device_address, reg_address, value);
 }
 
 uint16_t mcp4xxx_get_nv_wiper(uint8_t device_address, mcp4xxx_wiper_t wiper)
 {
     uint8_t reg_address = (wiper == WIPER_0) ? NV_WIPER_0_ADDRESS : NV_WIPER_1_ADDRESS;
     return mcpxxx_read(device_address, reg_address);
+}
+
+bool mcp4xxx_set_nv_wiper_async(uint8_t device_address, mcp4xxx_wiper_t wiper, uint16_t value,
+                                mcp4xxx_nv_callback_t callback)
+{
+    mcp4xxx_device_t *device = mcp4xxx_device_of(device_address);
+    if (!mcp4xxx_set_nv_wiper(device_address, wiper, value))
+    {
+        return false;
+    }
+    device->nv_pending = true;
+    device->nv_address = device_address;
+    device->nv_polls = 0;
+    device->nv_callback = callback;
+    return true;
+}
+
+void mcp4xxx_nv_task(void)
+{
+    for (uint8_t i = 0; i < MCP4XXX_MAX_DEVICES; i++)
+    {
+        mcp4xxx_device_t *device = &mcp4xxx_devices[i];
+        if (!device->nv_pending)
+        {
+            continue;
+        }
+
+        // The device may NACK while busy; keep polling until the limit
+        uint16_t status_reg = 0;
+        driver_status_t status = mcp4xxx_read_register(device->nv_address, STATUS_ADDRESS, &status_reg);
+        if (status == DRIVER_STATUS_OK && (status_reg & MCP4XXX_STATUS_EEWA) == 0)
+        {
+            device->nv_pending = false;
+        }
+        else if (++device->nv_polls >= MCP4XXX_NV_MAX_POLLS)
+        {
+            device->nv_pending = false;
+            status = (status == DRIVER_STATUS_OK) ? DRIVER_STATUS_TIMEOUT : status;
+            driver_health_error(&device->health, status);
+            mcp4xxx_cache_drop(device, NV_WIPER_0_ADDRESS);
+            mcp4xxx_cache_drop(device, NV_WIPER_1_ADDRESS);
+        }
+        else
+        {
+            continue;
+        }
+
+        if (device->nv_callback != NULL)
+        {
+            device->nv_callback(device->nv_address, status);
+        }
+    }
+}
+
+bool mcp4xxx_nv_busy(uint8_t device_address)
+{
+    return mcp4xxx_device_of(device_address)->nv_pending;
+}
+
+uint8_t mcp4xxx_scan(void)
+{
+    uint8_t present = 0;
+    for (uint8_t i = 0; i < MCP4XXX_MAX_DEVICES; i++)
+    {
+        if (mcp4xxx_i2c_write_buffer(MCP4XXX_BASE_ADDRESS | i, NULL, 0) == DRIVER_STATUS_OK)
+        {
+            present |= (uint8_t)(1U << i);
+        }
+    }
+    return present;
+}
+
+driver_status_t mcp4xxx_group_write(mcp4xxx_group_write_t *writes, uint8_t count, uint8_t *failed)
+{
+    uint16_t commands[MCP4XXX_MAX_GROUP];
+    uint16_t rejected = 0;
+    uint8_t failed_devices = 0;
+    driver_status_t result = DRIVER_STATUS_OK;
+
+    if (failed != NULL)
+    {
+        *failed = 0;
+    }
+    if (writes == NULL || count == 0 || count > MCP4XXX_MAX_GROUP)
+    {
+        if (writes != NULL && count != 0)
+        {
+            driver_health_error(mcp4xxx_health_of(writes[0].device_address), DRIVER_STATUS_INVALID_ARG);
+        }
+        return DRIVER_STATUS_INVALID_ARG;
+    }
+
+    // Validate and encode everything before touching the bus
+    for (uint8_t i = 0; i < count; i++)
+    {
+        mcp4xxx_device_t *device = mcp4xxx_device_of(writes[i].device_address);
+        uint8_t reg_address = writes[i].reg_address;
+        uint16_t data = writes[i].data;
+        writes[i].status = DRIVER_STATUS_OK;
+        if (data > 0x1FF || !mcp4xxx_has_register(device, reg_address) ||
+            (mcp4xxx_high_speed && mcp4xxx_is_nonvolatile(reg_address)))
+        {
+            writes[i].status = DRIVER_STATUS_INVALID_ARG;
+            rejected |= (uint16_t)(1U << i);
+        }
+        else if (device->nv_pending && mcp4xxx_is_nonvolatile(reg_address))
+        {
+            writes[i].status = DRIVER_STATUS_BUSY;
+            rejected |= (uint16_t)(1U << i);
+        }
+        commands[i] = (uint16_t)(((reg_address << 4) | WRITE_CMD | (data >> 8)) << 8) | (data & 0xFF);
+    }
+
+    // Back-to-back transactions
+    for (uint8_t i = 0; i < count; i++)
+    {
+        if (!(rejected & (1U << i)))
+        {
+            writes[i].status = mcp4xxx_i2c_write(writes[i].device_address, commands[i]);
+        }
+    }
+
+    // Bookkeeping and retries
+    for (uint8_t i = 0; i < count; i++)
+    {
+        uint8_t device_address = writes[i].device_address;
+        mcp4xxx_device_t *device = mcp4xxx_device_of(device_address);
+        driver_status_t status = writes[i].status;
+        if (rejected & (1U << i))
+        {
+            driver_health_error(&device->health, status);
+        }
+        else
+        {
+            for (uint8_t retry = 0; retry < MCP4XXX_I2C_RETRIES && mcp4xxx_retryable(status); retry++)
+            {
+                driver_health_retry(&device->health);
+                status = mcp4xxx_i2c_write(device_address, commands[i]);
+            }
+            driver_health_transfer(&device->health, status);
+        }
+
+        writes[i].status = status;
+        if (status == DRIVER_STATUS_OK)
+        {
+            mcp4xxx_cache_store(device, writes[i].reg_address, writes[i].data);
+        }
+        else
+        {
+            mcp4xxx_cache_drop(device, writes[i].reg_address);
+            failed_devices |= (uint8_t)(1U << (device_address & MCP4XXX_DEVICE_MASK));
+            if (result == DRIVER_STATUS_OK)
+            {
+                result = status;
+            }
+        }
+    }
+    if (failed != NULL)
+    {
+        *failed = failed_devices;
+    }
+    return result;
+}
+
+/**
+ * @brief Move a wiper to a position with the fewest bytes on the bus
+ *
+ * An absolute write costs the address, command and data bytes; a run of
+ * n increment/decrement commands costs the address plus n bytes.
+ */
+static bool mcp4xxx_ramp_move(mcp4xxx_ramp_t *ramp, mcp4xxx_wiper_t wiper, uint16_t position)
+{
+    int16_t steps = (int16_t)position - (int16_t)ramp->position;
+    uint16_t distance = (uint16_t)((steps > 0) ? steps : -steps);
+    bool ok;
+
+    if (distance == 0)
+    {
+        return true;
+    }
+    if (1 + distance < 3)
+    {
+        ok = mcp4xxx_step_wiper(ramp->address, wiper, steps);
+    }
+    else
+    {
+        ok = mcp4xxx_set_wiper(ramp->address, wiper, position);
+    }
+    if (ok)
+    {
+        ramp->position = position;
+    }
+    return ok;
+}
+
+bool mcp4xxx_ramp_start(uint8_t device_address, mcp4xxx_wiper_t wiper, uint16_t target, uint16_t ticks)
+{
+    mcp4xxx_device_t *device = mcp4xxx_device_of(device_address);
+    if (wiper > WIPER_1 || !mcp4xxx_has_register(device, (uint8_t)wiper) ||
+        target > mcp4xxx_max_wiper(device_address))
+    {
+        driver_health_error(&device->health, DRIVER_STATUS_INVALID_ARG);
+        return false;
+    }
+
+    // The ramp starts from the real position, normally served from the cache
+    uint16_t position = mcp4xxx_get_wiper(device_address, wiper);
+    if (position == 0xFFFF)
+    {
+        return false;
+    }
+
+    mcp4xxx_ramp_t *ramp = &device->ramp[wiper];
+    ramp->address = device_address;
+    ramp->start = position;
+    ramp->position = position;
+    ramp->target = target;
+    ramp->elapsed = 0;
+    ramp->ticks = ticks;
+    ramp->active = true;
+    return true;
+}
+
+uint8_t mcp4xxx_ramp_tick(void)
+{
+    uint8_t active = 0;
+    for (uint8_t i = 0; i < MCP4XXX_MAX_DEVICES; i++)
+    {
+        for (uint8_t w = 0; w < 2; w++)
+        {
+            mcp4xxx_ramp_t *ramp = &mcp4xxx_devices[i].ramp[w];
+            if (!ramp->active)
+            {
+                continue;
+            }
+
+            uint16_t position = ramp->target;
+            if (++ramp->elapsed < ramp->ticks)
+            {
+                int32_t span = (int32_t)ramp->target - (int32_t)ramp->start;
+                position = (uint16_t)(ramp->start + span * ramp->elapsed / ramp->ticks);
+            }
+            if (!mcp4xxx_ramp_move(ramp, (mcp4xxx_wiper_t)w, position) || position == ramp->target)
+            {
+                ramp->active = false;
+                continue;
+            }
+            active++;
+        }
+    }
+    return active;
+}
+
+void mcp4xxx_ramp_stop(uint8_t device_address, mcp4xxx_wiper_t wiper)
+{
+    mcp4xxx_device_t *device = mcp4xxx_device_of(device_address);
+    if (wiper > WIPER_1)
+    {
+        driver_health_error(&device->health, DRIVER_STATUS_INVALID_ARG);
+        return;
+    }
+    device->ramp[wiper].active = false;
+}
+
+bool mcp4xxx_ramp_active(uint8_t device_address, mcp4xxx_wiper_t wiper)
+{
+    mcp4xxx_device_t *device = mcp4xxx_device_of(device_address);
+    if (wiper > WIPER_1)
+    {
+        driver_health_error(&device->health, DRIVER_STATUS_INVALID_ARG);
+        return false;
+    }
+    return device->ramp[wiper].active;
+}
+
+bool mcp4xxx_resistance_init(mcp4xxx_resistance_t *res, uint8_t device_address, mcp4xxx_wiper_t wiper,
+                             uint32_t r_ab, uint32_t r_w)
+{
+    mcp4xxx_device_t *device = mcp4xxx_device_of(device_address);
+    // full_scale / r_ab must stay below 1 for the Q32 reciprocal to fit
+    if (res == NULL || r_ab <= mcp4xxx_max_wiper(device_address) || r_ab > UINT32_MAX - r_w ||
+        !mcp4xxx_has_wiper(device_address, wiper))
+    {
+        driver_health_error(&device->health, DRIVER_STATUS_INVALID_ARG);
+        return false;
+    }
+
+    res->device_address = device_address;
+    res->wiper = wiper;
+    res->full_scale = mcp4xxx_max_wiper(device_address);
+    res->r_ab = r_ab;
+    res->r_w = r_w;
+    res->inverse = (uint32_t)(((uint64_t)res->full_scale << 32) / r_ab);
+    for (uint16_t code = 0; code <= res->full_scale; code++)
+    {
+        res->ohms[code] = r_w + (uint32_t)(((uint64_t)r_ab * code + res->full_scale / 2) / res->full_scale);
+    }
+    return true;
+}
+
+uint32_t mcp4xxx_code_to_ohms(const mcp4xxx_resistance_t *res, uint16_t code)
+{
+    return res->ohms[(code > res->full_scale) ? res->full_scale : code];
+}
+
+uint16_t mcp4xxx_ohms_to_code(const mcp4xxx_resistance_t *res, uint32_t ohms)
+{
+    if (ohms <= res->ohms[0])
+    {
+        return 0;
+    }
+    if (ohms >= res->ohms[res->full_scale])
+    {
+        return res->full_scale;
+    }
+
+    // The reciprocal gives the code at or just below the request; the table
+    // then picks the nearer of it and its neighbour
+    uint16_t code = (uint16_t)(((uint64_t)(ohms - res->r_w) * res->inverse) >> 32);
+    if (code >= res->full_scale)
+    {
+        code = res->full_scale - 1;
+    }
+    while (code > 0 && res->ohms[code] > ohms)
+    {
+        code--;
+    }
+    while (res->ohms[code + 1] <= ohms && code + 1 < res->full_scale)
+    {
+        code++;
+    }
+    return (ohms - res->ohms[code] <= res->ohms[code + 1] - ohms) ? code : code + 1;
+}
+
+uint32_t mcp4xxx_code_to_ratio(const mcp4xxx_resistance_t *res, uint16_t code)
+{
+    code = (code > res->full_scale) ? res->full_scale : code;
+    return (((uint32_t)code << 16) + res->full_scale / 2) / res->full_scale;
+}
+
+uint16_t mcp4xxx_ratio_to_code(const mcp4xxx_resistance_t *res, uint32_t ratio)
+{
+    ratio = (ratio > 65536) ? 65536 : ratio;
+    return (uint16_t)((ratio * res->full_scale + 32768) >> 16);
+}
+
+bool mcp4xxx_set_resistance(const mcp4xxx_resistance_t *res, uint32_t ohms)
+{
+    return mcp4xxx_set_wiper(res->device_address, res->wiper, mcp4xxx_ohms_to_code(res, ohms));
+}
+
+bool mcp4xxx_session_begin(void)
+{
+    if (!mcp4xxx_high_speed)
+    {
+        mcp4xxx_high_speed = mcp4xxx_i2c_set_speed(MCP4XXX_I2C_SPEED_HIGH) == DRIVER_STATUS_OK;
+    }
+    return mcp4xxx_high_speed;
+}
+
+void mcp4xxx_session_end(void)
+{
+    if (mcp4xxx_high_speed)
+    {
+        mcp4xxx_i2c_set_speed(MCP4XXX_I2C_SPEED_FAST);
+        mcp4xxx_high_speed = false;
+    }
+}
+
+bool mcp4xxx_session_run(mcp4xxx_op_t *ops, uint8_t count)
+{
+    bool all_ok = true;
+    bool own_session = !mcp4xxx_high_speed;
+    if (ops == NULL)
+    {
+        return false;
+    }
+
+    mcp4xxx_session_begin();
+    for (uint8_t i = 0; i < count; i++)
+    {
+        mcp4xxx_op_t *op = &ops[i];
+        bool ok;
+        switch (op->command)
+        {
+            case WRITE_CMD:
+                ok = mcpxxx_write(op->device_address, op->reg_address, op->data);
+                break;
+            case READ_CMD:
+                op->data = mcpxxx_read(op->device_address, op->reg_address);
+                ok = op->data != 0xFFFF;
+                break;
+            case INCREMENT_CMD:
+            case DECREMENT_CMD:
+                // reg_address names the wiper; the other registers cannot be stepped
+                if (!mcp4xxx_has_wiper(op->device_address, (mcp4xxx_wiper_t)op->reg_address))
+                {
+                    driver_health_error(mcp4xxx_health_of(op->device_address), DRIVER_STATUS_INVALID_ARG);
+                    ok = false;
+                }
+                else if (op->command == INCREMENT_CMD)
+                {
+                    ok = mcp4xxx_increment_wiper(op->device_address, (mcp4xxx_wiper_t)op->reg_address);
+                }
+                else
+                {
+                    ok = mcp4xxx_decrement_wiper(op->device_address, (mcp4xxx_wiper_t)op->reg_address);
+                }
+                break;
+            default:
+                driver_health_error(mcp4xxx_health_of(op->device_address), DRIVER_STATUS_INVALID_ARG);
+                ok = false;
+                break;
+        }
+        op->status = ok ? DRIVER_STATUS_OK : mcp4xxx_health_of(op->device_address)->last_error;
+        all_ok = all_ok && ok;
+    }
+    if (own_session)
+    {
+        mcp4xxx_session_end(); // Leave a session opened by the caller running
+    }
+    return all_ok;
+}
+
+bool mcp4xxx_refresh(uint8_t device_address)
+{
+    mcp4xxx_device_t *device = mcp4xxx_device_of(device_address);
+    bool ok = true;
+    for (uint8_t reg_address = 0; reg_address < MCP4XXX_SHADOW_REGISTERS; reg_address++)
+    {
+        uint16_t data;
+        if (mcp4xxx_has_register(device, reg_address) &&
+            mcp4xxx_read_register(device_address, reg_address, &data) != DRIVER_STATUS_OK)
+        {
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+void mcp4xxx_invalidate(uint8_t device_address)
+{
+    mcp4xxx_device_of(device_address)->valid = 0;
+}
+
+const driver_health_t* mcp4xxx_get_health(uint8_t device_address)
+{
+    return mcp4xxx_health_of(device_address);
+}
+
+void mcp4xxx_reset_health(uint8_t device_address)
+{
+    driver_health_reset(mcp4xxx_health_of(device_address));
 }
\ No newline at end of file
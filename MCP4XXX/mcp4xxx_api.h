@@ -16,6 +16,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "driver_status.h"
+
 /**
  * @brief Command codes for MCP4XXX operations
  */
@@ -34,6 +36,24 @@
 #define TCON_ADDRESS        0x04  /**< Terminal control register address */
 #define STATUS_ADDRESS      0x05  /**< Status register address */
 
+/**
+ * @brief Bus configuration
+ */
+#define MCP4XXX_MAX_DEVICES     8     /**< Devices per bus (A0-A2 address pins) */
+#define MCP4XXX_BASE_ADDRESS    0x28  /**< 7-bit address with A2-A0 low */
+#define MCP4XXX_DEVICE_MASK     0x07  /**< Address bits selecting one of the MCP4XXX_MAX_DEVICES */
+#ifndef MCP4XXX_I2C_RETRIES
+#define MCP4XXX_I2C_RETRIES     1     /**< Extra attempts after a NACK or timeout */
+#endif
+#define MCP4XXX_MAX_STEPS       256   /**< Largest wiper movement of any model */
+#define MCP4XXX_MAX_BATCH       8     /**< Command/data pairs in one batched write */
+#define MCP4XXX_MAX_GROUP       (2 * MCP4XXX_MAX_DEVICES) /**< Writes in one group update */
+#define MCP4XXX_SHADOW_REGISTERS 5    /**< Registers kept in the shadow cache (WIPER_0 to TCON); STATUS changes on its own and is not cached */
+#define MCP4XXX_STATUS_EEWA     0x10  /**< STATUS bit set while an EEPROM write is active */
+#ifndef MCP4XXX_NV_MAX_POLLS
+#define MCP4XXX_NV_MAX_POLLS    1000  /**< STATUS polls before an asynchronous NV write times out */
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -53,10 +73,115 @@ typedef enum mcp4xxx_wiper {
     WIPER_1           /**< Wiper 1 (available only on dual channel devices) */
 } mcp4xxx_wiper_t;
 
+/**
+ * @brief One register write of a batch
+ */
+typedef struct {
+    uint8_t reg_address;    /**< WIPER_0_ADDRESS, WIPER_1_ADDRESS or TCON_ADDRESS */
+    uint16_t data;          /**< 9-bit register value */
+} mcp4xxx_write_t;
+
+/**
+ * @brief One register write of a group update
+ */
+typedef struct {
+    uint8_t device_address; /**< The I2C device address for the target device */
+    uint8_t reg_address;    /**< Register address to write */
+    uint16_t data;          /**< 9-bit register value */
+    driver_status_t status; /**< Result of the write, filled in by mcp4xxx_group_write() */
+} mcp4xxx_group_write_t;
+
+/**
+ * @brief Resistance calibration and lookup table of one wiper
+ *
+ * Filled in by mcp4xxx_resistance_init(). `ohms[code]` is the resistance
+ * between the wiper and terminal B for each wiper code, including the
+ * wiper resistance.
+ */
+typedef struct {
+    uint8_t device_address;     /**< The I2C device address of the device */
+    mcp4xxx_wiper_t wiper;      /**< Wiper described by the table */
+    uint16_t full_scale;        /**< Largest wiper code (128 or 256) */
+    uint32_t r_ab;              /**< Calibrated end-to-end resistance in ohms */
+    uint32_t r_w;               /**< Calibrated wiper resistance in ohms */
+    uint32_t inverse;           /**< full_scale / r_ab in Q32, for the reverse conversion */
+    uint32_t ohms[MCP4XXX_MAX_STEPS + 1]; /**< Wiper-to-B resistance of each code */
+} mcp4xxx_resistance_t;
+
+/**
+ * @brief One register operation of a high-speed session
+ */
+typedef struct {
+    uint8_t device_address; /**< The I2C device address for the target device */
+    uint8_t reg_address;    /**< Register address (WIPER_0 or WIPER_1 for increment/decrement) */
+    uint8_t command;        /**< WRITE_CMD, READ_CMD, INCREMENT_CMD or DECREMENT_CMD */
+    uint16_t data;          /**< Value to write, or value read back */
+    driver_status_t status; /**< Result of the operation, filled in by mcp4xxx_session_run() */
+} mcp4xxx_op_t;
+
+/**
+ * @brief Completion callback of an asynchronous non-volatile write
+ *
+ * Called from mcp4xxx_nv_task() with DRIVER_STATUS_OK once the EEPROM write
+ * has finished, or with the error that ended the polling.
+ */
+typedef void (*mcp4xxx_nv_callback_t)(uint8_t device_address, driver_status_t status);
+
+/**
+ * @brief Supported MCP4XXX models
+ * 
+ * The model sets the wiper range (129 or 257 steps) and the number of
+ * wipers of a device. Devices that have not been configured are treated
+ * as MCP4XXX_MODEL_UNKNOWN: all registers are accessible and the wiper
+ * range is not enforced by the library.
+ */
+typedef enum mcp4xxx_model {
+    MCP4XXX_MODEL_UNKNOWN = 0,  /**< Model not configured */
+    MCP4XXX_MODEL_MCP4541,      /**< Single, 7-bit potentiometer (129 steps) */
+    MCP4XXX_MODEL_MCP4542,      /**< Single, 7-bit rheostat (129 steps) */
+    MCP4XXX_MODEL_MCP4561,      /**< Single, 8-bit potentiometer (257 steps) */
+    MCP4XXX_MODEL_MCP4562,      /**< Single, 8-bit rheostat (257 steps) */
+    MCP4XXX_MODEL_MCP4641,      /**< Dual, 7-bit potentiometer (129 steps) */
+    MCP4XXX_MODEL_MCP4642,      /**< Dual, 7-bit rheostat (129 steps) */
+    MCP4XXX_MODEL_MCP4661,      /**< Dual, 8-bit potentiometer (257 steps) */
+    MCP4XXX_MODEL_MCP4662       /**< Dual, 8-bit rheostat (257 steps) */
+} mcp4xxx_model_t;
+
+/**
+ * @brief Declare the model of a device
+ *
+ * Sets the wiper range used for validation and for the shadow cache, and
+ * invalidates the cached registers of the device.
+ *
+ * @param device_address The I2C device address for the target device
+ * @param model Model of the device
+ * @return true if the model is valid, false otherwise
+ */
+bool mcp4xxx_configure(uint8_t device_address, mcp4xxx_model_t model);
+
+/**
+ * @brief Get the full-scale wiper value of a device
+ *
+ * @param device_address The I2C device address for the target device
+ * @return 128 for 129-step models, 256 for 257-step and unconfigured devices
+ */
+uint16_t mcp4xxx_max_wiper(uint8_t device_address);
+
+/**
+ * @brief Check that a wiper exists on the configured model of a device
+ *
+ * @param device_address The I2C device address for the target device
+ * @param wiper The wiper to check
+ * @return true for WIPER_0, and for WIPER_1 unless the device is a single
+ *         channel model, false otherwise
+ */
+bool mcp4xxx_has_wiper(uint8_t device_address, mcp4xxx_wiper_t wiper);
+
 /**
  * @brief Check if an MCP4XXX device is present and functioning
  *
  * This function attempts to communicate with the device to verify its presence.
+ * It always reads TCON from the bus and refreshes its cached value.
  *
  * @param device_address The I2C device address for the target device
  * @return true if device responds correctly, false otherwise
@@ -73,12 +198,30 @@ bool mcp4xxx_check(uint8_t device_address);
  */
 bool mcpxxx_write(uint8_t device_address, uint8_t reg_address, uint16_t data);
 
+/**
+ * @brief Write several volatile registers in one I2C transaction
+ *
+ * The command/data pairs are sent back to back between a single START and
+ * STOP condition. Only the volatile wipers and TCON can be written this way;
+ * non-volatile registers need a STOP after each write to start the EEPROM
+ * cycle and are rejected.
+ *
+ * @param device_address The I2C device address for the target device
+ * @param writes Register writes, sent in order
+ * @param count Number of writes (1 to MCP4XXX_MAX_BATCH)
+ * @return true if the transaction was successful, false otherwise
+ */
+bool mcp4xxx_write_batch(uint8_t device_address, const mcp4xxx_write_t *writes, uint8_t count);
+
 /**
  * @brief Read data from a specified register on an MCP4XXX device
  *
+ * Registers WIPER_0 to TCON are served from the shadow cache when valid.
+ * STATUS and the EEPROM registers are always read from the device.
+ *
  * @param device_address The I2C device address for the target device
  * @param reg_address Register address to read from
- * @return 16-bit data read from the register
+ * @return 16-bit data read from the register, 0xFFFF on failure
  */
 uint16_t mcpxxx_read(uint8_t device_address, uint8_t reg_address);
 
@@ -92,6 +235,16 @@ uint16_t mcpxxx_read(uint8_t device_address, uint8_t reg_address);
  */
 bool mcp4xxx_set_wiper(uint8_t device_address, mcp4xxx_wiper_t wiper, uint16_t value);
 
+/**
+ * @brief Set both wipers of a dual channel device in one I2C transaction
+ *
+ * @param device_address The I2C device address for the target device
+ * @param wiper0 The wiper 0 position value
+ * @param wiper1 The wiper 1 position value
+ * @return true if the operation was successful, false otherwise
+ */
+bool mcp4xxx_set_wipers(uint8_t device_address, uint16_t wiper0, uint16_t wiper1);
+
 /**
  * @brief Get the current wiper position
  *
@@ -105,11 +258,15 @@ uint16_t mcp4xxx_get_wiper(uint8_t device_address, mcp4xxx_wiper_t wiper);
  * @brief Increment the wiper position by one step
  *
  * This function increases the wiper position by one step. If the wiper is already
- * at the maximum position, it typically remains unchanged.
+ * at the maximum position, it typically remains unchanged. The cached wiper
+ * follows the device when the model is configured, and is invalidated otherwise.
+ * A failed command is not retried, since the device may have acted on it;
+ * the cached wiper is invalidated instead.
  *
  * @param device_address The I2C device address for the target device
  * @param wiper Which wiper to increment (WIPER_0 or WIPER_1 for dual devices)
- * @return true if the operation was successful, false otherwise
+ * @return true if the operation was successful, false otherwise. A wiper the
+ *         device does not have is rejected with DRIVER_STATUS_INVALID_ARG.
  */
 bool mcp4xxx_increment_wiper(uint8_t device_address, mcp4xxx_wiper_t wiper);
 
@@ -117,14 +274,39 @@ bool mcp4xxx_increment_wiper(uint8_t device_address, mcp4xxx_wiper_t wiper);
  * @brief Decrement the wiper position by one step
  *
  * This function decreases the wiper position by one step. If the wiper is already
- * at the minimum position (0), it typically remains unchanged.
+ * at the minimum position (0), it typically remains unchanged. The cached wiper
+ * follows the device. A failed command is not retried and invalidates the
+ * cached wiper.
  *
  * @param device_address The I2C device address for the target device
  * @param wiper Which wiper to decrement (WIPER_0 or WIPER_1 for dual devices)
- * @return true if the operation was successful, false otherwise
+ * @return true if the operation was successful, false otherwise. A wiper the
+ *         device does not have is rejected with DRIVER_STATUS_INVALID_ARG.
  */
 bool mcp4xxx_decrement_wiper(uint8_t device_address, mcp4xxx_wiper_t wiper);
 
+/**
+ * @brief Move the wiper by several steps in a single I2C transaction
+ *
+ * Sends one increment or decrement command byte per step between a single
+ * START and STOP condition. The number of commands is limited to the range of
+ * the configured model, and to the distance to the end of the range when the
+ * wiper position is cached.
+ *
+ * A transaction that fails part way may have moved the wiper, so it is not
+ * retried and the cached wiper is invalidated.
+ *
+ * The command bytes are built on the stack, one byte per step (up to
+ * MCP4XXX_MAX_STEPS), so the function keeps no static buffer.
+ *
+ * @param device_address The I2C device address for the target device
+ * @param wiper Which wiper to move (WIPER_0 or WIPER_1 for dual devices)
+ * @param steps Steps to move, positive towards terminal A, negative towards terminal B
+ * @return true if the operation was successful, false otherwise. A wiper the
+ *         device does not have is rejected with DRIVER_STATUS_INVALID_ARG.
+ */
+bool mcp4xxx_step_wiper(uint8_t device_address, mcp4xxx_wiper_t wiper, int16_t steps);
+
 /**
  * @brief Set the non-volatile wiper position to a specific value
  *
@@ -146,6 +328,266 @@ bool mcp4xxx_set_nv_wiper(uint8_t device_address, mcp4xxx_wiper_t wiper, uint16_
  */
 uint16_t mcp4xxx_get_nv_wiper(uint8_t device_address, mcp4xxx_wiper_t wiper);
 
+/**
+ * @brief Start a non-volatile wiper write without waiting for the EEPROM
+ *
+ * Issues the write and returns. Completion is detected by mcp4xxx_nv_task(),
+ * which polls the EEWA bit of the STATUS register. Until then, further
+ * non-volatile writes to the same device are rejected with DRIVER_STATUS_BUSY;
+ * other devices on the bus remain fully usable.
+ *
+ * @param device_address The I2C device address for the target device
+ * @param wiper Which wiper to set (WIPER_0 or WIPER_1 for dual devices)
+ * @param value The wiper position value
+ * @param callback Called on completion, may be NULL
+ * @return true if the write was issued, false otherwise
+ */
+bool mcp4xxx_set_nv_wiper_async(uint8_t device_address, mcp4xxx_wiper_t wiper, uint16_t value,
+                                mcp4xxx_nv_callback_t callback);
+
+/**
+ * @brief Poll the pending asynchronous non-volatile writes
+ *
+ * Must be called periodically from the main loop. Reads STATUS once per
+ * device with a write in flight. A write that is still active after
+ * MCP4XXX_NV_MAX_POLLS polls completes with DRIVER_STATUS_TIMEOUT.
+ */
+void mcp4xxx_nv_task(void);
+
+/**
+ * @brief Check whether a device has an EEPROM write in flight
+ *
+ * @param device_address The I2C device address for the target device
+ * @return true while an asynchronous non-volatile write is pending
+ */
+bool mcp4xxx_nv_busy(uint8_t device_address);
+
+/**
+ * @brief Probe the bus for MCP4XXX devices
+ *
+ * Sends one address-only transaction to each of the eight addresses
+ * MCP4XXX_BASE_ADDRESS to MCP4XXX_BASE_ADDRESS + 7. Probes are not retried
+ * and absent devices are not counted in the health counters.
+ *
+ * @return Presence bitmap, bit n set if the device with A2-A0 = n acknowledged
+ */
+uint8_t mcp4xxx_scan(void);
+
+/**
+ * @brief Write registers on several devices back to back
+ *
+ * All writes are validated and encoded first, then issued one transaction
+ * after the other with no processing in between. Retries, health counters
+ * and the shadow cache are handled once the whole group has been sent. The
+ * result of each write is stored in its `status` field.
+ *
+ * A group that is NULL, empty or longer than MCP4XXX_MAX_GROUP is rejected
+ * as a whole: nothing is sent, the `status` fields are left untouched and,
+ * for a group that is too long, DRIVER_STATUS_INVALID_ARG is recorded in
+ * the health counters of the device of the first write.
+ *
+ * @param writes Writes to perform, in order
+ * @param count Number of writes (1 to MCP4XXX_MAX_GROUP)
+ * @param failed Set to the bitmap of the devices (bit n for A2-A0 = n) with
+ *               at least one failed write, 0 if the group was rejected; may be NULL
+ * @return DRIVER_STATUS_OK if every write succeeded,
+ *         DRIVER_STATUS_INVALID_ARG if the group was rejected,
+ *         the status of the first failed write otherwise
+ */
+driver_status_t mcp4xxx_group_write(mcp4xxx_group_write_t *writes, uint8_t count, uint8_t *failed);
+
+/**
+ * @brief Start moving a wiper smoothly to a target position
+ *
+ * The ramp advances on each call to mcp4xxx_ramp_tick() and reaches the
+ * target after `ticks` calls, following a straight line. Each tick sends the
+ * cheapest command for the distance to cover: increment/decrement commands
+ * for small moves, an absolute write otherwise. Starting a ramp on a wiper
+ * that is already ramping replaces it.
+ *
+ * @param device_address The I2C device address for the target device
+ * @param wiper Which wiper to ramp (WIPER_0 or WIPER_1 for dual devices)
+ * @param target Final wiper position
+ * @param ticks Duration of the ramp in ticks, 0 to move on the next tick
+ * @return true if the ramp was started, false otherwise
+ */
+bool mcp4xxx_ramp_start(uint8_t device_address, mcp4xxx_wiper_t wiper, uint16_t target, uint16_t ticks);
+
+/**
+ * @brief Advance all active ramps by one tick
+ *
+ * Call at a fixed rate from the main loop, for example when a timer flag is
+ * set. A ramp that fails on the bus is stopped and its error is recorded in
+ * the health counters of the device.
+ *
+ * @return Number of ramps still active
+ */
+uint8_t mcp4xxx_ramp_tick(void);
+
+/**
+ * @brief Stop a ramp, leaving the wiper where it is
+ *
+ * A wiper other than WIPER_0 or WIPER_1 is rejected and counted as
+ * DRIVER_STATUS_INVALID_ARG in the health counters.
+ *
+ * @param device_address The I2C device address for the target device
+ * @param wiper Which wiper to stop
+ */
+void mcp4xxx_ramp_stop(uint8_t device_address, mcp4xxx_wiper_t wiper);
+
+/**
+ * @brief Check whether a wiper is ramping
+ *
+ * @param device_address The I2C device address for the target device
+ * @param wiper Which wiper to check
+ * @return true while the ramp has not reached its target, false for a
+ *         wiper other than WIPER_0 or WIPER_1
+ */
+bool mcp4xxx_ramp_active(uint8_t device_address, mcp4xxx_wiper_t wiper);
+
+/**
+ * @brief Build the resistance table of a wiper
+ *
+ * Uses the model set with mcp4xxx_configure() for the number of steps, so the
+ * device must be configured first. The table is built once here; the
+ * conversions below are constant time and use integer arithmetic only.
+ *
+ * @param res Table to fill in
+ * @param device_address The I2C device address for the target device
+ * @param wiper Which wiper the calibration applies to, one the device has
+ *              (see mcp4xxx_has_wiper())
+ * @param r_ab Measured end-to-end (A to B) resistance in ohms, more than one
+ *             ohm per step (above the full-scale value)
+ * @param r_w Measured wiper resistance in ohms
+ * @return true if the calibration is valid, false otherwise (counted as
+ *         DRIVER_STATUS_INVALID_ARG)
+ */
+bool mcp4xxx_resistance_init(mcp4xxx_resistance_t *res, uint8_t device_address, mcp4xxx_wiper_t wiper,
+                             uint32_t r_ab, uint32_t r_w);
+
+/**
+ * @brief Convert a wiper code to the wiper-to-B resistance
+ *
+ * @param res Resistance table of the wiper
+ * @param code Wiper code, clamped to full scale
+ * @return Resistance in ohms
+ */
+uint32_t mcp4xxx_code_to_ohms(const mcp4xxx_resistance_t *res, uint16_t code);
+
+/**
+ * @brief Convert a wiper-to-B resistance to the nearest wiper code
+ *
+ * @param res Resistance table of the wiper
+ * @param ohms Requested resistance, clamped to the range of the table
+ * @return Wiper code giving the closest resistance
+ */
+uint16_t mcp4xxx_ohms_to_code(const mcp4xxx_resistance_t *res, uint32_t ohms);
+
+/**
+ * @brief Convert a wiper code to the B-to-wiper divider ratio
+ *
+ * @param res Resistance table of the wiper
+ * @param code Wiper code, clamped to full scale
+ * @return Ratio in Q16 (65536 = wiper at terminal A)
+ */
+uint32_t mcp4xxx_code_to_ratio(const mcp4xxx_resistance_t *res, uint16_t code);
+
+/**
+ * @brief Convert a B-to-wiper divider ratio to the nearest wiper code
+ *
+ * @param res Resistance table of the wiper
+ * @param ratio Ratio in Q16, clamped to 65536
+ * @return Wiper code giving the closest ratio
+ */
+uint16_t mcp4xxx_ratio_to_code(const mcp4xxx_resistance_t *res, uint32_t ratio);
+
+/**
+ * @brief Set the wiper-to-B resistance of a wiper
+ *
+ * @param res Resistance table of the wiper
+ * @param ohms Requested resistance in ohms
+ * @return true if the operation was successful, false otherwise
+ */
+bool mcp4xxx_set_resistance(const mcp4xxx_resistance_t *res, uint32_t ohms);
+
+/**
+ * @brief Switch the bus to high-speed mode for a series of operations
+ *
+ * Every library call until mcp4xxx_session_end() runs at 3.4 MHz without
+ * releasing the bus. If the platform does not support high-speed mode the
+ * bus stays at its normal speed and the calls still work.
+ *
+ * The EEPROM write cycle only starts at a STOP condition, which a session
+ * never sends, so writes to NV_WIPER_0, NV_WIPER_1 and the EEPROM are
+ * rejected with DRIVER_STATUS_INVALID_ARG while the bus is in high-speed
+ * mode. Make them after mcp4xxx_session_end().
+ *
+ * @return true if the bus is in high-speed mode, false otherwise
+ */
+bool mcp4xxx_session_begin(void);
+
+/**
+ * @brief Release the bus and return to the normal speed
+ */
+void mcp4xxx_session_end(void);
+
+/**
+ * @brief Run a series of register operations in one high-speed session
+ *
+ * Read results are stored in the `data` field of each operation and the
+ * result of each operation in its `status` field. A failed operation does not
+ * stop the following ones. Writes to non-volatile registers fail with
+ * DRIVER_STATUS_INVALID_ARG when the session runs at high speed, see
+ * mcp4xxx_session_begin(), and so do increments and decrements of a wiper
+ * the device does not have (see mcp4xxx_has_wiper()).
+ *
+ * @param ops Operations to run, in order
+ * @param count Number of operations
+ * @return true if every operation succeeded, false otherwise
+ */
+bool mcp4xxx_session_run(mcp4xxx_op_t *ops, uint8_t count);
+
+/**
+ * @brief Reload the shadow cache of a device from the bus
+ *
+ * Reads the volatile wipers, non-volatile wipers and TCON. Only the
+ * registers that exist on the configured model are read, one combined
+ * write/read transaction each (3 for single, 5 for dual or unconfigured
+ * devices).
+ *
+ * @param device_address The I2C device address for the target device
+ * @return true if every register was read, false otherwise (failed registers stay invalid)
+ */
+bool mcp4xxx_refresh(uint8_t device_address);
+
+/**
+ * @brief Invalidate the shadow cache of a device
+ *
+ * The next read of each register goes to the bus. Call this after any
+ * event the library cannot see, such as a device power cycle.
+ *
+ * @param device_address The I2C device address for the target device
+ */
+void mcp4xxx_invalidate(uint8_t device_address);
+
+/**
+ * @brief Get the health counters of an MCP4XXX device
+ *
+ * Counters are kept per device, selected by the A0-A2 bits of the address.
+ * They are updated on every I2C transaction, retry and rejected call.
+ *
+ * @param device_address The I2C device address for the target device
+ * @return const driver_health_t* Pointer to the live counters of the device
+ */
+const driver_health_t* mcp4xxx_get_health(uint8_t device_address);
+
+/**
+ * @brief Clear the health counters of an MCP4XXX device
+ *
+ * @param device_address The I2C device address for the target device
+ */
+void mcp4xxx_reset_health(uint8_t device_address);
+
 #ifdef __cplusplus
 }
 #endif
@@ -15,21 +15,37 @@
 
 #include "peripheral/sercom/i2c_master/plib_sercom4_i2c_master.h"
 
-bool mcp4xxx_i2c_write(uint8_t device_address, uint16_t data)
+driver_status_t mcp4xxx_i2c_write(uint8_t device_address, uint16_t data)
 {
 	// TODO - Implement the I2C write function (2 bytes) for the specific platform
-    return false;
+    return DRIVER_STATUS_TIMEOUT;
 }
 
-uint16_t mcp4xxx_i2c_read(uint8_t device_address, uint8_t read_command)
+driver_status_t mcp4xxx_i2c_read(uint8_t device_address, uint8_t read_command, uint16_t *data)
 {
 	// TODO - Implement the I2C read function for the specific platform
     // - write the command to the device
     // - Read the 2-byte response from the device (MSB first)
-	return 0xFFFF;
+	return DRIVER_STATUS_TIMEOUT;
 }
 
-bool mcp4xxx_i2c_write_byte(uint8_t device_address, uint8_t data){
+driver_status_t mcp4xxx_i2c_write_byte(uint8_t device_address, uint8_t data){
     // TODO - Implement the I2C write byte function for the specific platform
-    return false;
+    return DRIVER_STATUS_TIMEOUT;
+}
+
+driver_status_t mcp4xxx_i2c_write_buffer(uint8_t device_address, const uint8_t *data, uint16_t length){
+    // TODO - Implement the I2C multi-byte write function for the specific platform
+    // - All bytes must be sent in a single transaction (one START, one STOP)
+    // - length 0: address-only probe for mcp4xxx_scan(), data may be NULL;
+    //   return DRIVER_STATUS_NACK when the address is not acknowledged
+    return DRIVER_STATUS_TIMEOUT;
+}
+
+driver_status_t mcp4xxx_i2c_set_speed(mcp4xxx_i2c_speed_t speed){
+    // TODO - Implement the bus speed change for the specific platform
+    // - HIGH: send the HS master code at fast-mode speed, then switch to 3.4 MHz
+    //   and end the following transactions with a repeated START
+    // - FAST: send a STOP and restore the fast-mode clock
+    return (speed == MCP4XXX_I2C_SPEED_FAST) ? DRIVER_STATUS_OK : DRIVER_STATUS_INVALID_ARG;
 }
\ No newline at end of file
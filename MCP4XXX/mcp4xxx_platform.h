@@ -15,36 +15,82 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "driver_status.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief I2C bus speeds supported by the MCP4XXX
+ */
+typedef enum mcp4xxx_i2c_speed {
+    MCP4XXX_I2C_SPEED_FAST = 0,     /**< Standard or fast mode (100 or 400 kHz), the default */
+    MCP4XXX_I2C_SPEED_HIGH          /**< High-speed mode (3.4 MHz) */
+} mcp4xxx_i2c_speed_t;
+
 /**
  * @brief Writes data to an MCP4XXX device over I2C
  * 
  * @param device_address The 7-bit I2C address of the target device
  * @param data 16-bit data to be written to the device
- * @return bool true if write was successful, false otherwise
+ * @return driver_status_t DRIVER_STATUS_OK if write was successful,
+ *         DRIVER_STATUS_NACK or DRIVER_STATUS_TIMEOUT otherwise
  */
-bool mcp4xxx_i2c_write(uint8_t device_address, uint16_t data);
+driver_status_t mcp4xxx_i2c_write(uint8_t device_address, uint16_t data);
 
 /**
  * @brief Reads data from an MCP4XXX device over I2C
  * 
  * @param device_address The 7-bit I2C address of the target device
  * @param read_command The command byte to initiate the read operation
- * @return uint16_t The 16-bit data read from the device, 0xFFFF on failure
+ * @param data Pointer to store the 16-bit data read from the device (MSB first)
+ * @return driver_status_t DRIVER_STATUS_OK if read was successful,
+ *         DRIVER_STATUS_NACK or DRIVER_STATUS_TIMEOUT otherwise
  */
-uint16_t mcp4xxx_i2c_read(uint8_t device_address, uint8_t read_command);
+driver_status_t mcp4xxx_i2c_read(uint8_t device_address, uint8_t read_command, uint16_t *data);
 
 /**
  * @brief Write a byte to an MCP4XXX device over I2C
  * 
  * @param device_address The 7-bit I2C address of the target device
  * @param data The byte to be written to the device
- * @return bool true if write was successful, false otherwise
+ * @return driver_status_t DRIVER_STATUS_OK if write was successful,
+ *         DRIVER_STATUS_NACK or DRIVER_STATUS_TIMEOUT otherwise
+ */
+driver_status_t mcp4xxx_i2c_write_byte(uint8_t device_address, uint8_t data);
+
+/**
+ * @brief Write several bytes to an MCP4XXX device in one I2C transaction
+ *
+ * The bytes must be sent between a single START and STOP condition. A
+ * length of 0 is an address-only probe used by mcp4xxx_scan(): the address
+ * is sent, the acknowledge is checked and the transaction ends; `data` may
+ * then be NULL and must not be read.
+ *
+ * @param device_address The 7-bit I2C address of the target device
+ * @param data Bytes to be written to the device, NULL allowed if length is 0
+ * @param length Number of bytes to write, 0 for an address-only probe
+ * @return driver_status_t DRIVER_STATUS_OK if write was successful (or the
+ *         probed device acknowledged), DRIVER_STATUS_NACK or
+ *         DRIVER_STATUS_TIMEOUT otherwise
+ */
+driver_status_t mcp4xxx_i2c_write_buffer(uint8_t device_address, const uint8_t *data, uint16_t length);
+
+/**
+ * @brief Change the I2C bus speed
+ *
+ * Switching to MCP4XXX_I2C_SPEED_HIGH sends the HS master code (0000 1xxx)
+ * at fast-mode speed, then reconfigures the peripheral for 3.4 MHz. The bus
+ * must stay in high-speed mode until switched back: transactions in between
+ * end with a repeated START instead of a STOP. Switching back to
+ * MCP4XXX_I2C_SPEED_FAST sends the STOP and restores the fast-mode clock.
+ *
+ * @param speed Requested bus speed
+ * @return driver_status_t DRIVER_STATUS_OK if the bus is at the requested speed,
+ *         DRIVER_STATUS_INVALID_ARG if the platform does not support it
  */
-bool mcp4xxx_i2c_write_byte(uint8_t device_address, uint8_t data);
+driver_status_t mcp4xxx_i2c_set_speed(mcp4xxx_i2c_speed_t speed);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,124 @@
+/**
+ * @file mcp4xxx_platform_mock.c
+ * @brief Recording MCP4XXX platform for host builds
+ *
+ * @author Alejandro Beltran
+ * @date October 2026
+ */
+
+#include "mcp4xxx_platform_mock.h"
+
+#include <string.h>
+
+mcp4xxx_mock_t mcp4xxx_mock;
+
+void mcp4xxx_mock_reset(void)
+{
+    memset(&mcp4xxx_mock, 0, sizeof(mcp4xxx_mock));
+    mcp4xxx_mock.high_speed_supported = true;
+    mcp4xxx_mock.present = 0xFF;
+    for (uint8_t i = 0; i < MCP4XXX_MAX_DEVICES; i++)
+    {
+        mcp4xxx_mock.reg[i][WIPER_0_ADDRESS] = 0x80;
+        mcp4xxx_mock.reg[i][WIPER_1_ADDRESS] = 0x80;
+        mcp4xxx_mock.reg[i][NV_WIPER_0_ADDRESS] = 0x80;
+        mcp4xxx_mock.reg[i][NV_WIPER_1_ADDRESS] = 0x80;
+        mcp4xxx_mock.reg[i][TCON_ADDRESS] = 0x1FF;
+    }
+}
+
+/**
+ * @brief Record a transaction; false if the device does not acknowledge
+ */
+static bool mcp4xxx_mock_record(uint8_t device_address, const uint8_t *data, uint16_t length, bool read)
+{
+    if (mcp4xxx_mock.call_count < MCP4XXX_MOCK_CALLS)
+    {
+        mcp4xxx_mock_call_t *call = &mcp4xxx_mock.calls[mcp4xxx_mock.call_count++];
+        call->speed = mcp4xxx_mock.speed;
+        call->device_address = device_address;
+        call->length = length;
+        call->read = read;
+        if (length != 0)
+        {
+            // A zero-length write is an address-only probe with no data
+            memcpy(call->bytes, data, (length < MCP4XXX_MOCK_BYTES) ? length : MCP4XXX_MOCK_BYTES);
+        }
+    }
+    return (device_address & ~MCP4XXX_DEVICE_MASK) == MCP4XXX_BASE_ADDRESS &&
+           (mcp4xxx_mock.present & (1U << (device_address & MCP4XXX_DEVICE_MASK)));
+}
+
+/**
+ * @brief Run a stream of write, increment and decrement commands
+ */
+static void mcp4xxx_mock_execute(uint8_t device_address, const uint8_t *data, uint16_t length)
+{
+    uint16_t *reg = mcp4xxx_mock.reg[device_address & MCP4XXX_DEVICE_MASK];
+    uint16_t i = 0;
+    while (i < length)
+    {
+        uint8_t address = data[i] >> 4;
+        uint8_t command = data[i] & (0x03 << 2);
+        if (command == WRITE_CMD && i + 1 < length)
+        {
+            reg[address] = (uint16_t)((data[i] & 0x01) << 8) | data[i + 1];
+            i += 2;
+            continue;
+        }
+        if (command == INCREMENT_CMD && reg[address] < 256)
+        {
+            reg[address]++;
+        }
+        else if (command == DECREMENT_CMD && reg[address] > 0)
+        {
+            reg[address]--;
+        }
+        i++;
+    }
+}
+
+driver_status_t mcp4xxx_i2c_write(uint8_t device_address, uint16_t data)
+{
+    uint8_t bytes[2] = { (uint8_t)(data >> 8), (uint8_t)data };
+    return mcp4xxx_i2c_write_buffer(device_address, bytes, 2);
+}
+
+driver_status_t mcp4xxx_i2c_read(uint8_t device_address, uint8_t read_command, uint16_t *data)
+{
+    if (!mcp4xxx_mock_record(device_address, &read_command, 1, true))
+    {
+        return DRIVER_STATUS_NACK;
+    }
+    *data = mcp4xxx_mock.reg[device_address & MCP4XXX_DEVICE_MASK][read_command >> 4];
+    return DRIVER_STATUS_OK;
+}
+
+driver_status_t mcp4xxx_i2c_write_byte(uint8_t device_address, uint8_t data)
+{
+    return mcp4xxx_i2c_write_buffer(device_address, &data, 1);
+}
+
+driver_status_t mcp4xxx_i2c_write_buffer(uint8_t device_address, const uint8_t *data, uint16_t length)
+{
+    if (!mcp4xxx_mock_record(device_address, data, length, false))
+    {
+        return DRIVER_STATUS_NACK;
+    }
+    mcp4xxx_mock_execute(device_address, data, length);
+    return DRIVER_STATUS_OK;
+}
+
+driver_status_t mcp4xxx_i2c_set_speed(mcp4xxx_i2c_speed_t speed)
+{
+    if (speed == MCP4XXX_I2C_SPEED_HIGH && !mcp4xxx_mock.high_speed_supported)
+    {
+        return DRIVER_STATUS_INVALID_ARG;
+    }
+    if (mcp4xxx_mock.speed_count < MCP4XXX_MOCK_CALLS)
+    {
+        mcp4xxx_mock.speeds[mcp4xxx_mock.speed_count++] = speed;
+    }
+    mcp4xxx_mock.speed = speed;
+    return DRIVER_STATUS_OK;
+}
@@ -0,0 +1,58 @@
+/**
+ * @file mcp4xxx_platform_mock.h
+ * @brief Recording MCP4XXX platform for host builds
+ *
+ * Replaces mcp4xxx_platform.c in host builds. Every bus transaction is
+ * recorded with the bus speed, the device address and the bytes sent, and
+ * speed changes are recorded in order. A zero-length write is recorded as an
+ * address-only probe, acknowledged by the present devices. Register writes, reads and wiper
+ * steps act on a simple model of eight devices, so the driver sees
+ * consistent data.
+ *
+ * @author Alejandro Beltran
+ * @date October 2026
+ */
+
+#ifndef MCP4XXX_PLATFORM_MOCK_H
+#define MCP4XXX_PLATFORM_MOCK_H
+
+#include "mcp4xxx_platform.h"
+#include "mcp4xxx_api.h"
+
+#define MCP4XXX_MOCK_CALLS 64
+#define MCP4XXX_MOCK_BYTES 8
+
+/**
+ * @brief One recorded bus transaction
+ */
+typedef struct {
+    mcp4xxx_i2c_speed_t speed;          /**< Bus speed during the transaction */
+    uint8_t device_address;             /**< 7-bit address */
+    uint8_t bytes[MCP4XXX_MOCK_BYTES];  /**< First bytes sent after the address */
+    uint16_t length;                    /**< Bytes sent after the address */
+    bool read;                          /**< Two bytes were read back */
+} mcp4xxx_mock_call_t;
+
+/**
+ * @brief Recorded traffic and device model
+ */
+typedef struct {
+    mcp4xxx_mock_call_t calls[MCP4XXX_MOCK_CALLS];
+    uint8_t call_count;
+    mcp4xxx_i2c_speed_t speeds[MCP4XXX_MOCK_CALLS];   /**< Speeds set, in order */
+    uint8_t speed_count;
+    mcp4xxx_i2c_speed_t speed;          /**< Current bus speed */
+    bool high_speed_supported;          /**< mcp4xxx_i2c_set_speed() accepts HIGH */
+    uint8_t present;                    /**< Bitmap of the devices that acknowledge */
+    uint16_t reg[MCP4XXX_MAX_DEVICES][16];
+} mcp4xxx_mock_t;
+
+extern mcp4xxx_mock_t mcp4xxx_mock;
+
+/**
+ * @brief Clears the record and resets the devices: all present, wipers at
+ *        mid-scale, TCON 0x1FF, high-speed mode supported
+ */
+void mcp4xxx_mock_reset(void);
+
+#endif /* MCP4XXX_PLATFORM_MOCK_H */
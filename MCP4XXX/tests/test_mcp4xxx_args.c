@@ -0,0 +1,148 @@
+/**
+ * @file test_mcp4xxx_args.c
+ * @brief Host tests of the MCP4XXX argument validation
+ *
+ * Each rejected call must fail with DRIVER_STATUS_INVALID_ARG in the health
+ * counters of the device and must not reach the bus.
+ *
+ * @author Alejandro Beltran
+ * @date October 2026
+ */
+
+#include "mcp4xxx_platform_mock.h"
+
+#include <stdio.h>
+
+#define CHECK(condition) do { \
+        if(!(condition)){ \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            failures++; \
+        } \
+    } while(0)
+
+#define TEST_DUAL   (MCP4XXX_BASE_ADDRESS | 0x01)
+#define TEST_SINGLE (MCP4XXX_BASE_ADDRESS | 0x02)
+
+static int failures;
+
+static void test_setup(void){
+    mcp4xxx_mock_reset();
+    mcp4xxx_configure(TEST_DUAL, MCP4XXX_MODEL_MCP4661);
+    mcp4xxx_configure(TEST_SINGLE, MCP4XXX_MODEL_MCP4561);
+    mcp4xxx_reset_health(TEST_DUAL);
+    mcp4xxx_reset_health(TEST_SINGLE);
+}
+
+/**
+ * @brief Checks that exactly `count` calls were rejected without traffic
+ */
+static bool test_rejected(uint8_t device_address, uint32_t count){
+    const driver_health_t *health = mcp4xxx_get_health(device_address);
+    return mcp4xxx_mock.call_count == 0 && health->invalid_args == count &&
+           (count == 0 || health->last_error == DRIVER_STATUS_INVALID_ARG);
+}
+
+static void test_wipers(void){
+    test_setup();
+    CHECK(mcp4xxx_has_wiper(TEST_DUAL, WIPER_0));
+    CHECK(mcp4xxx_has_wiper(TEST_DUAL, WIPER_1));
+    CHECK(mcp4xxx_has_wiper(TEST_SINGLE, WIPER_0));
+    CHECK(!mcp4xxx_has_wiper(TEST_SINGLE, WIPER_1));
+    CHECK(!mcp4xxx_has_wiper(TEST_DUAL, (mcp4xxx_wiper_t)NV_WIPER_0_ADDRESS));
+    CHECK(!mcp4xxx_has_wiper(TEST_DUAL, (mcp4xxx_wiper_t)7));
+
+    // Registers past the wipers, and indexes past the shadow cache
+    CHECK(!mcp4xxx_increment_wiper(TEST_DUAL, (mcp4xxx_wiper_t)TCON_ADDRESS));
+    CHECK(!mcp4xxx_decrement_wiper(TEST_DUAL, (mcp4xxx_wiper_t)NV_WIPER_1_ADDRESS));
+    CHECK(!mcp4xxx_increment_wiper(TEST_DUAL, (mcp4xxx_wiper_t)7));
+    CHECK(!mcp4xxx_step_wiper(TEST_DUAL, (mcp4xxx_wiper_t)7, 10));
+    CHECK(!mcp4xxx_step_wiper(TEST_DUAL, (mcp4xxx_wiper_t)15, -10));
+    CHECK(test_rejected(TEST_DUAL, 5));
+
+    CHECK(!mcp4xxx_increment_wiper(TEST_SINGLE, WIPER_1));
+    CHECK(!mcp4xxx_step_wiper(TEST_SINGLE, WIPER_1, 1));
+    CHECK(test_rejected(TEST_SINGLE, 2));
+
+    CHECK(mcp4xxx_step_wiper(TEST_DUAL, WIPER_1, 3));
+    CHECK(mcp4xxx_mock.call_count == 1 && mcp4xxx_mock.calls[0].length == 3);
+    CHECK(mcp4xxx_mock.reg[1][WIPER_1_ADDRESS] == 0x83);
+}
+
+static void test_resistance(void){
+    static mcp4xxx_resistance_t res;
+    test_setup();
+
+    // The NV wiper and TCON registers are not wipers
+    CHECK(!mcp4xxx_resistance_init(&res, TEST_DUAL, (mcp4xxx_wiper_t)NV_WIPER_0_ADDRESS, 10000, 75));
+    CHECK(!mcp4xxx_resistance_init(&res, TEST_DUAL, (mcp4xxx_wiper_t)TCON_ADDRESS, 10000, 75));
+    CHECK(!mcp4xxx_resistance_init(&res, TEST_SINGLE, WIPER_1, 10000, 75));
+    CHECK(test_rejected(TEST_DUAL, 2));
+    CHECK(test_rejected(TEST_SINGLE, 1));
+
+    CHECK(mcp4xxx_resistance_init(&res, TEST_DUAL, WIPER_1, 10000, 75));
+    CHECK(mcp4xxx_set_resistance(&res, 5075));
+    CHECK(mcp4xxx_mock.call_count == 1);
+    CHECK(mcp4xxx_mock.calls[0].bytes[0] >> 4 == WIPER_1_ADDRESS);
+    CHECK(mcp4xxx_mock.reg[1][WIPER_1_ADDRESS] == 128);
+}
+
+static void test_group(void){
+    mcp4xxx_group_write_t group[MCP4XXX_MAX_GROUP + 1];
+    uint8_t failed = 0xAA;
+    test_setup();
+    for(uint8_t i = 0; i <= MCP4XXX_MAX_GROUP; i++){
+        group[i] = (mcp4xxx_group_write_t){ TEST_DUAL, WIPER_0_ADDRESS, 0x40, DRIVER_STATUS_BUSY };
+    }
+
+    // Rejected groups: nothing is sent and no write gets a status
+    CHECK(mcp4xxx_group_write(NULL, 1, &failed) == DRIVER_STATUS_INVALID_ARG && failed == 0);
+    CHECK(mcp4xxx_group_write(group, 0, NULL) == DRIVER_STATUS_INVALID_ARG);
+    CHECK(test_rejected(TEST_DUAL, 0));
+    failed = 0xAA;
+    CHECK(mcp4xxx_group_write(group, MCP4XXX_MAX_GROUP + 1, &failed) == DRIVER_STATUS_INVALID_ARG);
+    CHECK(failed == 0 && group[0].status == DRIVER_STATUS_BUSY);
+    CHECK(test_rejected(TEST_DUAL, 1));
+
+    // Every device absent: the bitmap has all eight bits set
+    test_setup();
+    mcp4xxx_mock.present = 0;
+    for(uint8_t i = 0; i < MCP4XXX_MAX_DEVICES; i++){
+        group[i] = (mcp4xxx_group_write_t){ MCP4XXX_BASE_ADDRESS | i, WIPER_0_ADDRESS, 0x40, DRIVER_STATUS_OK };
+    }
+    CHECK(mcp4xxx_group_write(group, MCP4XXX_MAX_DEVICES, &failed) == DRIVER_STATUS_NACK);
+    CHECK(failed == 0xFF && group[7].status == DRIVER_STATUS_NACK);
+
+    // One device absent
+    mcp4xxx_mock.present = (uint8_t)~(1U << 2);
+    CHECK(mcp4xxx_group_write(group, MCP4XXX_MAX_DEVICES, &failed) == DRIVER_STATUS_NACK);
+    CHECK(failed == (1U << 2) && group[1].status == DRIVER_STATUS_OK);
+    CHECK(mcp4xxx_mock.reg[1][WIPER_0_ADDRESS] == 0x40);
+    mcp4xxx_mock.present = 0xFF;
+    CHECK(mcp4xxx_group_write(group, MCP4XXX_MAX_DEVICES, NULL) == DRIVER_STATUS_OK);
+}
+
+static void test_scan(void){
+    test_setup();
+    mcp4xxx_mock.present = (1U << 1) | (1U << 6);
+    CHECK(mcp4xxx_scan() == ((1U << 1) | (1U << 6)));
+
+    // One address-only probe per address
+    CHECK(mcp4xxx_mock.call_count == MCP4XXX_MAX_DEVICES);
+    for(uint8_t i = 0; i < mcp4xxx_mock.call_count; i++){
+        CHECK(mcp4xxx_mock.calls[i].device_address == (MCP4XXX_BASE_ADDRESS | i));
+        CHECK(mcp4xxx_mock.calls[i].length == 0 && !mcp4xxx_mock.calls[i].read);
+    }
+}
+
+int main(void){
+    test_wipers();
+    test_resistance();
+    test_group();
+    test_scan();
+    if(failures != 0){
+        printf("test_mcp4xxx_args: %d checks failed\n", failures);
+        return 1;
+    }
+    printf("test_mcp4xxx_args: all tests passed\n");
+    return 0;
+}
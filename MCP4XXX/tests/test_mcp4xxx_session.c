@@ -0,0 +1,169 @@
+/**
+ * @file test_mcp4xxx_session.c
+ * @brief Host tests of the MCP4XXX high-speed sessions
+ *
+ * The driver runs against the recording platform of mcp4xxx_platform_mock.c.
+ * The tests check the speed changes around a session and the speed and
+ * content of every transaction made inside it.
+ *
+ * @author Alejandro Beltran
+ * @date October 2026
+ */
+
+#include "mcp4xxx_platform_mock.h"
+
+#include <stdio.h>
+
+#define CHECK(condition) do { \
+        if(!(condition)){ \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            failures++; \
+        } \
+    } while(0)
+
+#define TEST_DEVICE (MCP4XXX_BASE_ADDRESS | 0x01)
+
+static int failures;
+
+static void test_setup(void){
+    mcp4xxx_mock_reset();
+    mcp4xxx_configure(TEST_DEVICE, MCP4XXX_MODEL_MCP4661);
+    mcp4xxx_invalidate(TEST_DEVICE);
+}
+
+static bool test_all_at(mcp4xxx_i2c_speed_t speed){
+    for(uint8_t i = 0; i < mcp4xxx_mock.call_count; i++){
+        if(mcp4xxx_mock.calls[i].speed != speed){
+            return false;
+        }
+    }
+    return true;
+}
+
+static void test_session_run(void){
+    mcp4xxx_op_t ops[] = {
+        { TEST_DEVICE, WIPER_0_ADDRESS, WRITE_CMD, 0x40, DRIVER_STATUS_OK },
+        { TEST_DEVICE, WIPER_1_ADDRESS, READ_CMD, 0, DRIVER_STATUS_OK },
+        { TEST_DEVICE, WIPER_1, INCREMENT_CMD, 0, DRIVER_STATUS_OK },
+        { TEST_DEVICE, WIPER_0, DECREMENT_CMD, 0, DRIVER_STATUS_OK },
+    };
+    test_setup();
+    CHECK(mcp4xxx_session_run(ops, 4));
+
+    // One switch to HS before the first transaction, one back after the last
+    CHECK(mcp4xxx_mock.speed_count == 2);
+    CHECK(mcp4xxx_mock.speeds[0] == MCP4XXX_I2C_SPEED_HIGH);
+    CHECK(mcp4xxx_mock.speeds[1] == MCP4XXX_I2C_SPEED_FAST);
+    CHECK(mcp4xxx_mock.speed == MCP4XXX_I2C_SPEED_FAST);
+    CHECK(mcp4xxx_mock.call_count == 4);
+    CHECK(test_all_at(MCP4XXX_I2C_SPEED_HIGH));
+
+    const mcp4xxx_mock_call_t *call = mcp4xxx_mock.calls;
+    CHECK(call[0].device_address == TEST_DEVICE && call[0].length == 2 && !call[0].read);
+    CHECK(call[0].bytes[0] == ((WIPER_0_ADDRESS << 4) | WRITE_CMD) && call[0].bytes[1] == 0x40);
+    CHECK(call[1].read && call[1].bytes[0] == ((WIPER_1_ADDRESS << 4) | READ_CMD));
+    CHECK(call[2].length == 1 && call[2].bytes[0] == ((WIPER_1_ADDRESS << 4) | INCREMENT_CMD));
+    CHECK(call[3].length == 1 && call[3].bytes[0] == ((WIPER_0_ADDRESS << 4) | DECREMENT_CMD));
+
+    for(uint8_t i = 0; i < 4; i++){
+        CHECK(ops[i].status == DRIVER_STATUS_OK);
+    }
+    CHECK(ops[1].data == 0x80);
+    CHECK(mcp4xxx_mock.reg[1][WIPER_0_ADDRESS] == 0x3F);
+    CHECK(mcp4xxx_mock.reg[1][WIPER_1_ADDRESS] == 0x81);
+}
+
+static void test_caller_session(void){
+    mcp4xxx_op_t ops[] = {
+        { TEST_DEVICE, WIPER_0_ADDRESS, WRITE_CMD, 0x10, DRIVER_STATUS_OK },
+    };
+    test_setup();
+    CHECK(mcp4xxx_session_begin());
+    CHECK(mcp4xxx_session_begin());
+    CHECK(mcp4xxx_session_run(ops, 1));
+    CHECK(mcp4xxx_set_wiper(TEST_DEVICE, WIPER_1, 0x20));
+    CHECK(mcp4xxx_session_run(ops, 1));
+
+    // Runs inside a session opened by the caller leave the speed alone
+    CHECK(mcp4xxx_mock.speed_count == 1);
+    CHECK(mcp4xxx_mock.speed == MCP4XXX_I2C_SPEED_HIGH);
+    mcp4xxx_session_end();
+    mcp4xxx_session_end();
+    CHECK(mcp4xxx_mock.speed_count == 2);
+    CHECK(mcp4xxx_mock.speeds[1] == MCP4XXX_I2C_SPEED_FAST);
+    CHECK(mcp4xxx_mock.call_count == 3);
+    CHECK(test_all_at(MCP4XXX_I2C_SPEED_HIGH));
+}
+
+static void test_nonvolatile(void){
+    mcp4xxx_op_t ops[] = {
+        { TEST_DEVICE, WIPER_0_ADDRESS, WRITE_CMD, 0x10, DRIVER_STATUS_OK },
+        { TEST_DEVICE, NV_WIPER_0_ADDRESS, WRITE_CMD, 0x10, DRIVER_STATUS_OK },
+        { TEST_DEVICE, WIPER_1_ADDRESS, WRITE_CMD, 0x20, DRIVER_STATUS_OK },
+    };
+    test_setup();
+    CHECK(!mcp4xxx_session_run(ops, 3));
+    CHECK(ops[0].status == DRIVER_STATUS_OK);
+    CHECK(ops[1].status == DRIVER_STATUS_INVALID_ARG);
+    CHECK(ops[2].status == DRIVER_STATUS_OK);
+
+    // The rejected write never reaches the bus
+    CHECK(mcp4xxx_mock.call_count == 2);
+    CHECK(mcp4xxx_mock.calls[0].bytes[0] >> 4 == WIPER_0_ADDRESS);
+    CHECK(mcp4xxx_mock.calls[1].bytes[0] >> 4 == WIPER_1_ADDRESS);
+    CHECK(mcp4xxx_mock.reg[1][NV_WIPER_0_ADDRESS] == 0x80);
+    CHECK(mcp4xxx_mock.speed_count == 2);
+}
+
+static void test_step_registers(void){
+    mcp4xxx_op_t ops[] = {
+        { TEST_DEVICE, NV_WIPER_0_ADDRESS, INCREMENT_CMD, 0, DRIVER_STATUS_OK },
+        { TEST_DEVICE, TCON_ADDRESS, DECREMENT_CMD, 0, DRIVER_STATUS_OK },
+        { TEST_DEVICE, 7, INCREMENT_CMD, 0, DRIVER_STATUS_OK },
+        { TEST_DEVICE, WIPER_1_ADDRESS, DECREMENT_CMD, 0, DRIVER_STATUS_OK },
+    };
+    test_setup();
+    CHECK(!mcp4xxx_session_run(ops, 4));
+    CHECK(ops[0].status == DRIVER_STATUS_INVALID_ARG);
+    CHECK(ops[1].status == DRIVER_STATUS_INVALID_ARG);
+    CHECK(ops[2].status == DRIVER_STATUS_INVALID_ARG);
+    CHECK(ops[3].status == DRIVER_STATUS_OK);
+
+    // Only the wiper step reaches the bus
+    CHECK(mcp4xxx_mock.call_count == 1);
+    CHECK(mcp4xxx_mock.calls[0].bytes[0] == ((WIPER_1_ADDRESS << 4) | DECREMENT_CMD));
+    CHECK(mcp4xxx_mock.reg[1][NV_WIPER_0_ADDRESS] == 0x80);
+    CHECK(mcp4xxx_mock.reg[1][TCON_ADDRESS] == 0x1FF);
+}
+
+static void test_no_high_speed(void){
+    mcp4xxx_op_t ops[] = {
+        { TEST_DEVICE, WIPER_0_ADDRESS, WRITE_CMD, 0x10, DRIVER_STATUS_OK },
+        { TEST_DEVICE, NV_WIPER_0_ADDRESS, WRITE_CMD, 0x10, DRIVER_STATUS_OK },
+    };
+    test_setup();
+    mcp4xxx_mock.high_speed_supported = false;
+
+    // The session falls back to the normal speed, where NV writes are allowed
+    CHECK(!mcp4xxx_session_begin());
+    CHECK(mcp4xxx_session_run(ops, 2));
+    mcp4xxx_session_end();
+    CHECK(mcp4xxx_mock.speed_count == 0);
+    CHECK(mcp4xxx_mock.call_count == 2);
+    CHECK(test_all_at(MCP4XXX_I2C_SPEED_FAST));
+    CHECK(mcp4xxx_mock.reg[1][NV_WIPER_0_ADDRESS] == 0x10);
+}
+
+int main(void){
+    test_session_run();
+    test_caller_session();
+    test_nonvolatile();
+    test_step_registers();
+    test_no_high_speed();
+    if(failures != 0){
+        printf("test_mcp4xxx_session: %d checks failed\n", failures);
+        return 1;
+    }
+    printf("test_mcp4xxx_session: all tests passed\n");
+    return 0;
+}
@@ -0,0 +1,157 @@
+/**
+ * @file scene_api.c
+ * @brief Implementation of precompiled bus transaction scenes
+ *
+ * @author Alejandro Beltran
+ * @date October 2026
+ */
+
+#include "scene_api.h"
+#include "scene_platform.h"
+
+#include "mcp48fvxx_api.h"
+#include "mcp4xxx_api.h"
+
+static driver_status_t scene_compile_step(scene_t *scene, const scene_step_t *step, bool *merge_power)
+{
+    switch (step->kind)
+    {
+        case SCENE_DAC_OUTPUT:
+        {
+            scene_spi_op_t *op = &scene->spi[scene->spi_count++];
+            op->power_mask = 0;
+            *merge_power = false;
+            return mcp48fvxx_output_frame(step->channel, step->value, &op->frame) ? DRIVER_STATUS_OK
+                                                                                  : DRIVER_STATUS_INVALID_ARG;
+        }
+        case SCENE_DAC_POWER:
+        {
+            if (step->channel > 1)
+            {
+                return DRIVER_STATUS_INVALID_ARG;
+            }
+            if (!*merge_power)
+            {
+                scene_spi_op_t *op = &scene->spi[scene->spi_count++];
+                op->frame = 0;
+                op->power_mask = 0;
+                *merge_power = true;
+            }
+            scene_spi_op_t *op = &scene->spi[scene->spi_count - 1];
+            uint8_t shift = step->channel * 2;
+            op->power_mask |= 0x03 << shift;
+            op->frame &= ~(0x03U << shift);
+            op->frame |= (uint32_t)(step->value ? MCP48FVXX_CHANNEL_ON : MCP48FVXX_CHANNEL_OFF) << shift;
+            return DRIVER_STATUS_OK;
+        }
+        case SCENE_POT_WIPER:
+        {
+            if (!mcp4xxx_has_wiper(step->device_address, (mcp4xxx_wiper_t)step->channel) ||
+                step->value > mcp4xxx_max_wiper(step->device_address))
+            {
+                return DRIVER_STATUS_INVALID_ARG;
+            }
+            scene_i2c_op_t *op = &scene->i2c[scene->i2c_count++];
+            op->device_address = step->device_address;
+            op->data[0] = (step->channel << 4) | WRITE_CMD | (step->value >> 8);
+            op->data[1] = step->value & 0xFF;
+            return DRIVER_STATUS_OK;
+        }
+        default:
+            return DRIVER_STATUS_INVALID_ARG;
+    }
+}
+
+driver_status_t scene_compile(scene_t *scene, const scene_step_t *steps, uint8_t count)
+{
+    if (scene == NULL || steps == NULL || count == 0 || count > SCENE_MAX_STEPS)
+    {
+        return DRIVER_STATUS_INVALID_ARG;
+    }
+
+    bool merge_power = false;
+    scene->spi_count = 0;
+    scene->i2c_count = 0;
+    for (uint8_t i = 0; i < count; i++)
+    {
+        driver_status_t status = scene_compile_step(scene, &steps[i], &merge_power);
+        if (status != DRIVER_STATUS_OK)
+        {
+            scene->spi_count = 0;
+            scene->i2c_count = 0;
+            return status;
+        }
+    }
+    scene_reset_stats(scene);
+    return DRIVER_STATUS_OK;
+}
+
+static inline void scene_keep_first(driver_status_t *result, driver_status_t status)
+{
+    if (*result == DRIVER_STATUS_OK)
+    {
+        *result = status;
+    }
+}
+
+driver_status_t scene_run(scene_t *scene)
+{
+    driver_status_t result = DRIVER_STATUS_OK;
+    uint32_t start = scene_platform_cycles();
+
+    // An SPI frame takes a few microseconds and an I2C write tens of them, so
+    // all the SPI frames are sent while the first I2C write is on the bus
+    bool i2c_busy = false;
+    if (scene->i2c_count > 0)
+    {
+        const scene_i2c_op_t *op = &scene->i2c[0];
+        driver_status_t status = scene_platform_i2c_start(op->device_address, op->data, sizeof(op->data));
+        i2c_busy = status == DRIVER_STATUS_OK;
+        scene_keep_first(&result, status);
+    }
+    for (uint8_t i = 0; i < scene->spi_count; i++)
+    {
+        const scene_spi_op_t *op = &scene->spi[i];
+        bool ok = (op->power_mask == 0) ? mcp48fvxx_write_frame(op->frame)
+                                        : mcp48fvxx_update_power(op->power_mask, (uint8_t)op->frame);
+        if (!ok)
+        {
+            scene_keep_first(&result, mcp48fvxx_get_health()->last_error);
+        }
+    }
+    if (i2c_busy)
+    {
+        scene_keep_first(&result, scene_platform_i2c_wait());
+    }
+    for (uint8_t i = 1; i < scene->i2c_count; i++)
+    {
+        const scene_i2c_op_t *op = &scene->i2c[i];
+        driver_status_t status = scene_platform_i2c_start(op->device_address, op->data, sizeof(op->data));
+        if (status == DRIVER_STATUS_OK)
+        {
+            status = scene_platform_i2c_wait();
+        }
+        scene_keep_first(&result, status);
+    }
+
+    uint32_t elapsed = (scene_platform_cycles() - start) / scene_platform_cycles_per_us();
+    scene->runs++;
+    scene->last_us = elapsed;
+    scene->max_us = (elapsed > scene->max_us) ? elapsed : scene->max_us;
+    scene->total_us += elapsed;
+
+    // The writes bypassed the MCP4XXX driver, so its cached wipers are stale
+    for (uint8_t i = 0; i < scene->i2c_count; i++)
+    {
+        mcp4xxx_invalidate(scene->i2c[i].device_address);
+    }
+    return result;
+}
+
+void scene_reset_stats(scene_t *scene)
+{
+    scene->runs = 0;
+    scene->last_us = 0;
+    scene->max_us = 0;
+    scene->total_us = 0;
+}
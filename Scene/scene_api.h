@@ -0,0 +1,123 @@
+/**
+ * @file scene_api.h
+ * @brief Precompiled bus transaction programs across the DAC and potentiometer drivers
+ *
+ * A scene is a fixed set of MCP48FVXX outputs, MCP48FVXX channel power states
+ * and MCP4XXX wiper positions that together make up one operating point of a
+ * fixture. scene_compile() validates and encodes the set once into flat lists
+ * of SPI frames and I2C writes; scene_run() replays them with no validation
+ * or encoding, overlapping the SPI frames with the first I2C write when the
+ * platform provides a non-blocking I2C write.
+ *
+ * @author Alejandro Beltran
+ * @date October 2026
+ */
+
+#ifndef SCENE_API_H
+#define SCENE_API_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "driver_status.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Maximum number of steps in one scene */
+#ifndef SCENE_MAX_STEPS
+#define SCENE_MAX_STEPS     16
+#endif
+
+/**
+ * @brief Kind of a scene step
+ */
+typedef enum scene_step_kind {
+    SCENE_DAC_OUTPUT = 0,   /**< mcp48fvxx_set_output(channel, value) */
+    SCENE_DAC_POWER,        /**< mcp48fvxx_channel_on_off(channel, value != 0) */
+    SCENE_POT_WIPER         /**< mcp4xxx_set_wiper(device_address, channel, value) */
+} scene_step_kind_t;
+
+/**
+ * @brief One step of a scene, as the equivalent driver call
+ */
+typedef struct {
+    scene_step_kind_t kind; /**< Driver call the step stands for */
+    uint8_t device_address; /**< MCP4XXX I2C address, ignored for DAC steps */
+    uint8_t channel;        /**< DAC channel or MCP4XXX wiper */
+    uint16_t value;         /**< DAC code, power state or wiper position */
+} scene_step_t;
+
+/**
+ * @brief Pre-encoded SPI transaction
+ *
+ * A zero `power_mask` sends `frame` as is; otherwise the power-down register
+ * bits in `power_mask` are set to those of `frame`.
+ */
+typedef struct {
+    uint32_t frame;
+    uint8_t power_mask;
+} scene_spi_op_t;
+
+/**
+ * @brief Pre-encoded I2C transaction
+ */
+typedef struct {
+    uint8_t device_address;
+    uint8_t data[2];
+} scene_i2c_op_t;
+
+/**
+ * @brief Compiled scene and its execution statistics
+ */
+typedef struct {
+    scene_spi_op_t spi[SCENE_MAX_STEPS];    /**< SPI transactions, in step order */
+    scene_i2c_op_t i2c[SCENE_MAX_STEPS];    /**< I2C transactions, in step order */
+    uint8_t spi_count;                      /**< Number of SPI transactions */
+    uint8_t i2c_count;                      /**< Number of I2C transactions */
+    uint32_t runs;                          /**< Completed replays */
+    uint32_t last_us;                       /**< Duration of the last replay */
+    uint32_t max_us;                        /**< Longest replay */
+    uint32_t total_us;                      /**< Sum of all replay durations */
+} scene_t;
+
+/**
+ * @brief Compile a list of steps into a scene
+ *
+ * Every step is validated against the same limits as the equivalent driver
+ * call. Consecutive power steps are merged into one read-modify-write.
+ *
+ * @param scene Scene to fill in
+ * @param steps Steps of the scene
+ * @param count Number of steps (1 to SCENE_MAX_STEPS)
+ * @return driver_status_t DRIVER_STATUS_OK on success, DRIVER_STATUS_INVALID_ARG otherwise
+ */
+driver_status_t scene_compile(scene_t *scene, const scene_step_t *steps, uint8_t count);
+
+/**
+ * @brief Replay a compiled scene
+ *
+ * SPI transactions run in step order, and so do I2C transactions. The SPI
+ * frames are sent while the first I2C write is on the bus, so the relative
+ * order of DAC and potentiometer steps is not kept. The shadow cache of
+ * every MCP4XXX written by the scene is invalidated. A failed transaction
+ * does not stop the others.
+ *
+ * @param scene Compiled scene
+ * @return driver_status_t DRIVER_STATUS_OK if every transaction succeeded, the first error otherwise
+ */
+driver_status_t scene_run(scene_t *scene);
+
+/**
+ * @brief Clear the execution statistics of a scene
+ *
+ * @param scene Compiled scene
+ */
+void scene_reset_stats(scene_t *scene);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCENE_API_H */
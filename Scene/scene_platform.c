@@ -0,0 +1,42 @@
+/**
+ * @file scene_platform.c
+ * @brief Implementation of platform-specific functions for bus transaction scenes
+ *
+ * These functions should be implemented according to the specific platform
+ * being used. The default I2C implementation is blocking and goes through
+ * the MCP4XXX platform layer, so scenes work before a non-blocking driver
+ * is available; SPI and I2C then simply do not overlap.
+ *
+ * @author Alejandro Beltran
+ * @date October 2026
+ */
+
+#include "scene_platform.h"
+#include "mcp4xxx_platform.h"
+
+static driver_status_t scene_i2c_status;
+
+driver_status_t scene_platform_i2c_start(uint8_t device_address, const uint8_t *data, uint8_t length)
+{
+    // TODO - Start a non-blocking write for the target platform, e.g. SERCOM4_I2C_Write()
+    scene_i2c_status = mcp4xxx_i2c_write_buffer(device_address, data, length);
+    return DRIVER_STATUS_OK;
+}
+
+driver_status_t scene_platform_i2c_wait(void)
+{
+    // TODO - Wait for the write started last, e.g. while (SERCOM4_I2C_IsBusy());
+    return scene_i2c_status;
+}
+
+uint32_t scene_platform_cycles(void)
+{
+    // TODO - Return a free-running cycle counter, e.g. DWT->CYCCNT
+    return 0;
+}
+
+uint32_t scene_platform_cycles_per_us(void)
+{
+    // TODO - Return the cycle counter frequency in MHz
+    return 1;
+}
@@ -0,0 +1,64 @@
+/**
+ * @file scene_platform.h
+ * @brief Platform-specific interface for bus transaction scenes
+ *
+ * This file declares the hardware abstraction layer functions needed to
+ * replay scenes: a non-blocking I2C write, so that potentiometer updates
+ * can run while the DAC is written over SPI, and a cycle counter to time
+ * each replay.
+ *
+ * @author Alejandro Beltran
+ * @date October 2026
+ */
+
+#ifndef SCENE_PLATFORM_H
+#define SCENE_PLATFORM_H
+
+#include <stdint.h>
+
+#include "driver_status.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Start an I2C write and return without waiting for it
+ *
+ * The buffer stays valid until scene_platform_i2c_wait() returns. A platform
+ * without a non-blocking I2C driver may perform the whole write here.
+ *
+ * @param device_address The 7-bit I2C address of the target device
+ * @param data Bytes to write
+ * @param length Number of bytes to write
+ * @return driver_status_t DRIVER_STATUS_OK if the write was started, the bus error otherwise
+ */
+driver_status_t scene_platform_i2c_start(uint8_t device_address, const uint8_t *data, uint8_t length);
+
+/**
+ * @brief Wait for the I2C write started last
+ *
+ * @return driver_status_t DRIVER_STATUS_OK if the write completed,
+ *         DRIVER_STATUS_NACK or DRIVER_STATUS_TIMEOUT otherwise
+ */
+driver_status_t scene_platform_i2c_wait(void);
+
+/**
+ * @brief Read a free-running cycle counter
+ *
+ * @return uint32_t Current cycle count, wrapping at 2^32
+ */
+uint32_t scene_platform_cycles(void);
+
+/**
+ * @brief Get the number of cycles per microsecond
+ *
+ * @return uint32_t Counter frequency in MHz
+ */
+uint32_t scene_platform_cycles_per_us(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCENE_PLATFORM_H */
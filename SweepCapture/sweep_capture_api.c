@@ -0,0 +1,238 @@
+/**
+ * @file sweep_capture_api.c
+ * @brief Implementation of the on-device sweep-and-capture engine
+ *
+ * @author Alejandro Beltran
+ * @date October 2026
+ */
+
+#include "sweep_capture_api.h"
+#include "sweep_capture_platform.h"
+
+#include "mcp48fvxx_api.h"
+#include "ads8866_api.h"
+#include "adc124s021_api.h"
+
+/**
+ * @brief Samples read per ADC124S021 burst
+ */
+#define SWEEP_CAPTURE_BURST 16
+
+/**
+ * @brief Engine state
+ *
+ * Two blocks are used in ping-pong: one is filled while the emit callback
+ * holds the other. A block is only reused once the block filled after it
+ * has been accepted.
+ */
+static struct {
+    sweep_capture_config_t config;
+    sweep_capture_emit_t emit;
+    sweep_capture_state_t state;
+    driver_status_t error;
+    uint32_t frame_base;            // DAC frame encoded with value 0
+    int32_t increment;              // Signed code increment per step
+    uint16_t code;                  // DAC code of the step being settled
+    uint16_t steps;                 // Total steps of the sweep
+    uint16_t captured;              // Steps captured so far
+    uint32_t step_time;             // Time the current DAC code was written
+    sweep_capture_block_t blocks[2];
+    uint8_t filling;                // Index of the block being filled
+} sweep;
+
+static void sweep_capture_fail(driver_status_t status)
+{
+    sweep.error = status;
+    sweep.state = SWEEP_CAPTURE_ERROR;
+}
+
+static bool sweep_capture_write_dac(uint16_t code)
+{
+    if (!mcp48fvxx_write_frame(sweep.frame_base | code))
+    {
+        sweep_capture_fail(mcp48fvxx_get_health()->last_error);
+        return false;
+    }
+    sweep.code = code;
+    sweep.step_time = sweep_capture_platform_time_us();
+    return true;
+}
+
+/**
+ * @brief Hand the full block to the callback and start filling the other one
+ *
+ * The other block was the last one accepted, so it is only reset once the
+ * callback has taken the full block in its place.
+ */
+static void sweep_capture_rotate(void)
+{
+    sweep_capture_block_t *block = &sweep.blocks[sweep.filling];
+    if (block->count == SWEEP_CAPTURE_BLOCK_POINTS && sweep.emit(block))
+    {
+        sweep.filling ^= 1;
+        sweep.blocks[sweep.filling].first_step = sweep.captured;
+        sweep.blocks[sweep.filling].count = 0;
+    }
+}
+
+/**
+ * @brief Capture and reduce the samples of the current step
+ */
+static bool sweep_capture_acquire(sweep_capture_point_t *point)
+{
+    uint32_t sum = 0;
+    uint16_t min = UINT16_MAX;
+    uint16_t max = 0;
+
+    if (sweep.config.adc == SWEEP_CAPTURE_ADC_ADS8866)
+    {
+        for (uint16_t i = 0; i < sweep.config.samples; i++)
+        {
+            uint16_t value = ads8866_read_raw();
+            sum += value;
+            min = (value < min) ? value : min;
+            max = (value > max) ? value : max;
+        }
+    }
+    else
+    {
+        uint16_t values[SWEEP_CAPTURE_BURST];
+        uint16_t remaining = sweep.config.samples;
+        while (remaining > 0)
+        {
+            uint16_t count = (remaining > SWEEP_CAPTURE_BURST) ? SWEEP_CAPTURE_BURST : remaining;
+            driver_status_t status = adc124s021_read_channel_burst(sweep.config.adc_channel, values, count);
+            if (status != DRIVER_STATUS_OK)
+            {
+                sweep_capture_fail(status);
+                return false;
+            }
+            for (uint16_t i = 0; i < count; i++)
+            {
+                sum += values[i];
+                min = (values[i] < min) ? values[i] : min;
+                max = (values[i] > max) ? values[i] : max;
+            }
+            remaining -= count;
+        }
+    }
+    point->mean = (uint16_t)((sum + sweep.config.samples / 2) / sweep.config.samples);
+    point->min = min;
+    point->max = max;
+    return true;
+}
+
+driver_status_t sweep_capture_start(const sweep_capture_config_t *config, sweep_capture_emit_t emit)
+{
+    if (sweep.state == SWEEP_CAPTURE_RUNNING)
+    {
+        return DRIVER_STATUS_BUSY;
+    }
+    if (config == NULL || emit == NULL || config->step == 0 || config->samples == 0 ||
+        config->start > 4095 || config->stop > 4095 ||
+        (config->adc != SWEEP_CAPTURE_ADC_ADS8866 && config->adc != SWEEP_CAPTURE_ADC_ADC124S021) ||
+        (config->adc == SWEEP_CAPTURE_ADC_ADC124S021 && config->adc_channel > 3))
+    {
+        return DRIVER_STATUS_INVALID_ARG;
+    }
+    if (!mcp48fvxx_output_frame(config->dac_channel, 0, &sweep.frame_base))
+    {
+        return DRIVER_STATUS_INVALID_ARG;
+    }
+
+    sweep.config = *config;
+    sweep.emit = emit;
+    if (config->start <= config->stop)
+    {
+        sweep.increment = config->step;
+        sweep.steps = (config->stop - config->start) / config->step + 1;
+    }
+    else
+    {
+        sweep.increment = -(int32_t)config->step;
+        sweep.steps = (config->start - config->stop) / config->step + 1;
+    }
+    sweep.captured = 0;
+    sweep.filling = 0;
+    sweep.blocks[0].first_step = 0;
+    sweep.blocks[0].count = 0;
+    sweep.error = DRIVER_STATUS_OK;
+    sweep.state = SWEEP_CAPTURE_RUNNING;
+
+    if (!sweep_capture_write_dac(config->start))
+    {
+        return sweep.error;
+    }
+    return DRIVER_STATUS_OK;
+}
+
+sweep_capture_state_t sweep_capture_task(void)
+{
+    if (sweep.state != SWEEP_CAPTURE_RUNNING)
+    {
+        return sweep.state;
+    }
+
+    if (sweep.captured == sweep.steps)
+    {
+        // Flush the last block; the callback keeps it after the sweep is done
+        sweep_capture_block_t *block = &sweep.blocks[sweep.filling];
+        if (block->count == 0 || sweep.emit(block))
+        {
+            sweep.state = SWEEP_CAPTURE_DONE;
+        }
+        return sweep.state;
+    }
+
+    // Offer a refused block again while the current step settles
+    sweep_capture_rotate();
+    if (sweep.blocks[sweep.filling].count == SWEEP_CAPTURE_BLOCK_POINTS)
+    {
+        return sweep.state; // The other block is still held, wait for the callback
+    }
+    if ((uint32_t)(sweep_capture_platform_time_us() - sweep.step_time) < sweep.config.settle_us)
+    {
+        return sweep.state;
+    }
+
+    sweep_capture_point_t point;
+    if (!sweep_capture_acquire(&point))
+    {
+        return sweep.state;
+    }
+    sweep.captured++;
+
+    // Start settling the next step before storing this one
+    if (sweep.captured < sweep.steps && !sweep_capture_write_dac((uint16_t)(sweep.code + sweep.increment)))
+    {
+        return sweep.state;
+    }
+
+    sweep_capture_block_t *block = &sweep.blocks[sweep.filling];
+    block->points[block->count++] = point;
+    sweep_capture_rotate();
+    return sweep.state;
+}
+
+void sweep_capture_abort(void)
+{
+    if (sweep.state == SWEEP_CAPTURE_RUNNING)
+    {
+        sweep.state = SWEEP_CAPTURE_IDLE;
+    }
+}
+
+sweep_capture_state_t sweep_capture_get_state(void)
+{
+    return sweep.state;
+}
+
+driver_status_t sweep_capture_get_error(void)
+{
+    return sweep.error;
+}
+
+uint16_t sweep_capture_get_steps(void)
+{
+    return sweep.steps;
+}
\ No newline at end of file
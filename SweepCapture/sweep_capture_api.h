@@ -0,0 +1,159 @@
+/**
+ * @file sweep_capture_api.h
+ * @brief On-device DAC sweep and ADC capture engine
+ *
+ * This module runs a production-test sweep entirely on the device: it steps
+ * an MCP48FVXX channel from a start to a stop code, waits a settle time,
+ * captures N samples from the ADS8866 or one ADC124S021 channel and reduces
+ * them to a compact mean/min/max record. Records are packed into blocks and
+ * handed to an application callback for streaming to the host.
+ *
+ * The engine is a cooperative task: sweep_capture_task() must be called from
+ * the main loop. As soon as a step has been captured the DAC is moved to the
+ * next code, and the settle time of that step is used to reduce the samples
+ * and emit completed blocks instead of busy-waiting.
+ *
+ * @author Alejandro Beltran
+ * @date October 2026
+ */
+
+#ifndef SWEEP_CAPTURE_API_H
+#define SWEEP_CAPTURE_API_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "driver_status.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Number of step records in one block */
+#ifndef SWEEP_CAPTURE_BLOCK_POINTS
+#define SWEEP_CAPTURE_BLOCK_POINTS  64
+#endif
+
+/**
+ * @brief ADC used to capture each step
+ */
+typedef enum sweep_capture_adc {
+    SWEEP_CAPTURE_ADC_ADS8866 = 0,  /**< ADS8866, 16-bit codes */
+    SWEEP_CAPTURE_ADC_ADC124S021    /**< One ADC124S021 channel, 12-bit codes */
+} sweep_capture_adc_t;
+
+/**
+ * @brief Sweep description
+ *
+ * The sweep goes from `start` towards `stop` in increments of `step`; it
+ * runs downwards when `start` is greater than `stop`. The last step is the
+ * last code that does not pass `stop`.
+ */
+typedef struct {
+    uint8_t dac_channel;            /**< MCP48FVXX channel to sweep */
+    uint16_t start;                 /**< First DAC code (0-4095) */
+    uint16_t stop;                  /**< Last DAC code (0-4095) */
+    uint16_t step;                  /**< Code increment between steps (> 0) */
+    uint32_t settle_us;             /**< Wait after each DAC step before capturing */
+    sweep_capture_adc_t adc;        /**< ADC used to capture */
+    uint8_t adc_channel;            /**< ADC124S021 channel (0-3), ignored for the ADS8866 */
+    uint16_t samples;               /**< ADC samples captured per step (> 0) */
+} sweep_capture_config_t;
+
+/**
+ * @brief Reduced capture of one step
+ *
+ * The DAC code of a record is start +/- (first_step + index) * step.
+ */
+typedef struct {
+    uint16_t mean;                  /**< Average of the captured samples */
+    uint16_t min;                   /**< Smallest captured sample */
+    uint16_t max;                   /**< Largest captured sample */
+} sweep_capture_point_t;
+
+/**
+ * @brief Block of step records handed to the application
+ */
+typedef struct {
+    uint16_t first_step;            /**< Index of the first record in the sweep */
+    uint16_t count;                 /**< Number of valid records */
+    sweep_capture_point_t points[SWEEP_CAPTURE_BLOCK_POINTS];  /**< Step records */
+} sweep_capture_block_t;
+
+/**
+ * @brief Block callback
+ *
+ * Called from sweep_capture_task() with each completed block. Return true
+ * when the block has been accepted (copied or queued for transmission); the
+ * block stays valid until the following block is accepted, or until the next
+ * sweep_capture_start() for the last block. Return false to have the engine
+ * offer the same block again on a later call; the sweep pauses meanwhile.
+ */
+typedef bool (*sweep_capture_emit_t)(const sweep_capture_block_t *block);
+
+/**
+ * @brief Engine state
+ */
+typedef enum sweep_capture_state {
+    SWEEP_CAPTURE_IDLE = 0,         /**< No sweep configured */
+    SWEEP_CAPTURE_RUNNING,          /**< Sweep in progress */
+    SWEEP_CAPTURE_DONE,             /**< All steps captured and emitted */
+    SWEEP_CAPTURE_ERROR             /**< Sweep stopped on a device error */
+} sweep_capture_state_t;
+
+/**
+ * @brief Start a sweep
+ *
+ * Validates the description and writes the first DAC code. The sweep then
+ * progresses through sweep_capture_task().
+ *
+ * @param config Sweep description
+ * @param emit Callback receiving the completed blocks
+ * @return driver_status_t DRIVER_STATUS_OK if the sweep started, DRIVER_STATUS_BUSY if a
+ *         sweep is already running, DRIVER_STATUS_INVALID_ARG or the DAC error otherwise
+ */
+driver_status_t sweep_capture_start(const sweep_capture_config_t *config, sweep_capture_emit_t emit);
+
+/**
+ * @brief Advance the running sweep
+ *
+ * Must be called periodically from the main loop. Never blocks longer
+ * than the capture of one step.
+ *
+ * @return sweep_capture_state_t Engine state after the call
+ */
+sweep_capture_state_t sweep_capture_task(void);
+
+/**
+ * @brief Abort the running sweep
+ *
+ * Blocks not yet emitted are discarded. The DAC keeps its last value.
+ */
+void sweep_capture_abort(void);
+
+/**
+ * @brief Get the engine state
+ *
+ * @return sweep_capture_state_t Current state
+ */
+sweep_capture_state_t sweep_capture_get_state(void);
+
+/**
+ * @brief Get the error that stopped the sweep
+ *
+ * @return driver_status_t DRIVER_STATUS_OK unless the state is SWEEP_CAPTURE_ERROR
+ */
+driver_status_t sweep_capture_get_error(void);
+
+/**
+ * @brief Get the total number of steps of the current sweep
+ *
+ * @return uint16_t Number of steps
+ */
+uint16_t sweep_capture_get_steps(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SWEEP_CAPTURE_API_H */
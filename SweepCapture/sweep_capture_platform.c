@@ -0,0 +1,18 @@
+/**
+ * @file sweep_capture_platform.c
+ * @brief Implementation of platform-specific functions for the sweep-and-capture engine
+ *
+ * These functions should be implemented according to the specific platform
+ * being used.
+ *
+ * @author Alejandro Beltran
+ * @date October 2026
+ */
+
+#include "sweep_capture_platform.h"
+
+uint32_t sweep_capture_platform_time_us(void)
+{
+    // TODO - Return a free-running microsecond counter for the target platform
+    return 0;
+}
\ No newline at end of file
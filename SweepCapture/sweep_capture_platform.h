@@ -0,0 +1,34 @@
+/**
+ * @file sweep_capture_platform.h
+ * @brief Platform-specific interface for the sweep-and-capture engine
+ *
+ * This file declares the hardware abstraction layer functions needed by
+ * the sweep engine to time the settle period of each step.
+ *
+ * @author Alejandro Beltran
+ * @date October 2026
+ */
+
+#ifndef SWEEP_CAPTURE_PLATFORM_H
+#define SWEEP_CAPTURE_PLATFORM_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Read a free-running microsecond counter
+ *
+ * The counter must count up and wrap at 2^32.
+ *
+ * @return uint32_t Current time in microseconds
+ */
+uint32_t sweep_capture_platform_time_us(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SWEEP_CAPTURE_PLATFORM_H */
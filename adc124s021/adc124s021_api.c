@@ -14,6 +14,7 @@
 #include "adc124s021_platform.h"
 
 static float adc124s021_vref = 3.3f; // Default reference voltage for the ADC124S021
+static driver_health_t adc124s021_health; // Health counters for the ADC124S021
 
 /**
  * @brief Initializes the ADC124S021.
@@ -21,25 +22,55 @@ static float adc124s021_vref = 3.3f; // Default reference voltage for the ADC124
  * This function sets up the SPI interface required to communicate with the ADC124S021.
  */
 void adc124s021_init(void) {
-    adc124s021_read_channel(0); // Dummy read to initialize the ADC.
+    uint16_t dummy;
+    adc124s021_read_channel(0, &dummy); // Dummy read to initialize the ADC.
 }
 
 /**
  * @brief Reads the ADC value from the specified channel.
  * 
  * @param channel The ADC channel to read (0-3).
- * @return uint16_t The 12-bit ADC value from the specified channel. Returns 0xFFFF if the channel is invalid.
+ * @param value Pointer to store the 12-bit ADC value. Left untouched on error.
+ * @return driver_status_t DRIVER_STATUS_OK on success, DRIVER_STATUS_INVALID_ARG if the channel is invalid.
  */
-uint16_t adc124s021_read_channel(uint8_t channel) {
+driver_status_t adc124s021_read_channel(uint8_t channel, uint16_t *value) {
     if (channel > 3) {
-        return 0xFFFF; // Invalid channel, return 0xFFFF.
+        return driver_health_error(&adc124s021_health, DRIVER_STATUS_INVALID_ARG);
     }
 
     uint16_t command = (channel & 0x03) << 11; // Prepare the command for the channel.
     adc124s021_platform_spi_transfer(command); // Read the previous sent channel and set the current channel
     uint16_t response = adc124s021_platform_spi_transfer(0x0000); // Read the current channel value and set channel 0 for the next read.
+    adc124s021_health.transfers += 2;
 
-    return response & 0x0FFF; // Extract the 12 least significant bits.
+    *value = response & 0x0FFF; // Extract the 12 least significant bits.
+    return DRIVER_STATUS_OK;
+}
+
+/**
+ * @brief Reads several consecutive conversions of the same channel.
+ * 
+ * @param channel The ADC channel to read (0-3).
+ * @param values Array to store the 12-bit ADC values.
+ * @param count Number of conversions to read.
+ * @return driver_status_t DRIVER_STATUS_OK on success, DRIVER_STATUS_INVALID_ARG if the channel is invalid.
+ */
+driver_status_t adc124s021_read_channel_burst(uint8_t channel, uint16_t *values, uint16_t count) {
+    if (channel > 3) {
+        return driver_health_error(&adc124s021_health, DRIVER_STATUS_INVALID_ARG);
+    }
+    if (count == 0) {
+        return DRIVER_STATUS_OK;
+    }
+
+    uint16_t command = (channel & 0x03) << 11; // Prepare the command for the channel.
+    adc124s021_platform_spi_transfer(command); // Read the previous sent channel and set the current channel
+    for (uint16_t i = 0; i < count - 1; i++) {
+        values[i] = adc124s021_platform_spi_transfer(command) & 0x0FFF; // Keep converting the same channel
+    }
+    values[count - 1] = adc124s021_platform_spi_transfer(0x0000) & 0x0FFF; // Set channel 0 for the next read.
+    adc124s021_health.transfers += count + 1;
+    return DRIVER_STATUS_OK;
 }
 
 /**
@@ -62,6 +93,7 @@ adc124s021_data_t adc124s021_read_all_channels(void) {
     value = adc124s021_platform_spi_transfer(0x0000) & 0x00FFF; // Read the current channel value and set channel 0 for the next read.
     data.channel[3] = value;
     data.voltage[3] = (value * adc124s021_vref) / 4096.0f; // Convert the ADC value to voltage.
+    adc124s021_health.transfers += 4;
     return data;
 }
 
@@ -79,6 +111,7 @@ bool adc124s021_set_vref(float vref){
         adc124s021_vref = vref;
         return true;
     }
+    driver_health_error(&adc124s021_health, DRIVER_STATUS_INVALID_ARG);
     return false;
 }
 
@@ -90,3 +123,19 @@ bool adc124s021_set_vref(float vref){
 float adc124s021_get_vref(void){
     return adc124s021_vref;
 }
+
+/**
+ * @brief Get the health counters of the ADC
+ * 
+ * @return const driver_health_t* Pointer to the live counters
+ */
+const driver_health_t* adc124s021_get_health(void){
+    return &adc124s021_health;
+}
+
+/**
+ * @brief Clear the health counters of the ADC
+ */
+void adc124s021_reset_health(void){
+    driver_health_reset(&adc124s021_health);
+}
@@ -17,6 +17,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "driver_status.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -33,9 +35,24 @@ void adc124s021_init(void);
  * @brief Reads the ADC value from the specified channel.
  * 
  * @param channel The ADC channel to read (0-3).
- * @return uint16_t The 12-bit ADC value from the specified channel. Returns 0xFFFF if the channel is invalid.
+ * @param value Pointer to store the 12-bit ADC value. Left untouched on error.
+ * @return driver_status_t DRIVER_STATUS_OK on success, DRIVER_STATUS_INVALID_ARG if the channel is invalid.
+ */
+driver_status_t adc124s021_read_channel(uint8_t channel, uint16_t *value);
+
+/**
+ * @brief Reads several consecutive conversions of the same channel.
+ * 
+ * The ADC124S021 selects the next channel during the current transfer, so
+ * repeated conversions of one channel need only one extra transfer in total
+ * instead of one per sample.
+ * 
+ * @param channel The ADC channel to read (0-3).
+ * @param values Array to store the 12-bit ADC values.
+ * @param count Number of conversions to read.
+ * @return driver_status_t DRIVER_STATUS_OK on success, DRIVER_STATUS_INVALID_ARG if the channel is invalid.
  */
-uint16_t adc124s021_read_channel(uint8_t channel);
+driver_status_t adc124s021_read_channel_burst(uint8_t channel, uint16_t *values, uint16_t count);
 
 /**
  * @brief Struct to hold ADC values for all channels.
@@ -76,6 +93,20 @@ bool adc124s021_set_vref(float vref);
  */
 float adc124s021_get_vref(void);
 
+/**
+ * @brief Get the health counters of the ADC
+ * 
+ * The counters are updated on every SPI transfer and every rejected call.
+ * 
+ * @return const driver_health_t* Pointer to the live counters
+ */
+const driver_health_t* adc124s021_get_health(void);
+
+/**
+ * @brief Clear the health counters of the ADC
+ */
+void adc124s021_reset_health(void);
+
 #ifdef __cplusplus
 }
 #endif